@@ -0,0 +1,81 @@
+
+// include system headers
+#include <vector>
+
+// include own headers
+#include "Benchmark.h"
+
+// include application headers
+#include "ChromaResampling.h"
+#include "ImageJfif.h"
+#include "PlanarImageCalc.h"
+#include "SyntheticImage.h"
+
+namespace imageshrink
+{
+
+void benchChromaResampling( const BenchmarkSettings & settings )
+{
+    const double megaPixels = settings.width * static_cast<double>( settings.height ) / 1.0e6;
+
+    SyntheticImage image444( settings.width, settings.height, ChrominanceSubsampling::CS_444 );
+    SyntheticImage image420( settings.width, settings.height, ChrominanceSubsampling::CS_420 );
+
+    // line kernels of every implementation on one chroma plane
+    const PlanarImageDesc desc444 = calcPlanaerImageDescForYUV( settings.width, settings.height, ChrominanceSubsampling::CS_444, TJ_PAD );
+    const PlanarImageDesc desc420 = calcPlanaerImageDescForYUV( settings.width, settings.height, ChrominanceSubsampling::CS_420, TJ_PAD );
+
+    const unsigned char * const plane444 = &image444.getImageBuffer()->image[ desc444.planeSize0 ];
+    const unsigned char * const plane420 = &image420.getImageBuffer()->image[ desc420.planeSize0 ];
+
+    std::vector<unsigned char> out420( desc420.planeSize1 );
+    std::vector<unsigned char> out444( desc444.planeSize1 );
+
+    for( int i = 0; i < getNofChromaResamplingImplementations(); ++i )
+    {
+        const ChromaResamplingImplementation & implementation = getChromaResamplingImplementation( i );
+
+        const Measurement measurementDown = measure( [&]()
+        {
+            for( int y = 0; y < desc444.height1 / 2; ++y )
+            {
+                implementation.downsample2x2( &plane444[ desc444.stride1 * ( 2 * y ) ],
+                                              &plane444[ desc444.stride1 * ( 2 * y + 1 ) ],
+                                              &out420[ desc420.stride1 * y ],
+                                              desc444.width1 / 2 );
+            }
+        }, settings.repetitions );
+
+        const Measurement measurementUp = measure( [&]()
+        {
+            for( int y = 0; y < desc444.height1 / 2; ++y )
+            {
+                implementation.upsample2x( &plane420[ desc420.stride1 * y ],
+                                           &out444[ desc444.stride1 * ( 2 * y ) ],
+                                           desc444.width1 / 2 );
+            }
+        }, settings.repetitions );
+
+        report( "chroma plane 444to420", implementation.name, megaPixels, measurementDown );
+        report( "chroma plane 420to444", implementation.name, megaPixels, measurementUp );
+    }
+
+    // complete conversion (all planes, selected implementation)
+    ImageJfif jfif444( image444 );
+    ImageJfif jfif420( image420 );
+
+    const Measurement measurementDown = measure( [&]()
+    {
+        jfif444.getImageWithChrominanceSubsampling( ChrominanceSubsampling::CS_420 );
+    }, settings.repetitions );
+
+    const Measurement measurementUp = measure( [&]()
+    {
+        jfif420.getImageWithChrominanceSubsampling( ChrominanceSubsampling::CS_444 );
+    }, settings.repetitions );
+
+    report( "image 444to420", getChromaResampling().name, megaPixels, measurementDown );
+    report( "image 420to444", getChromaResampling().name, megaPixels, measurementUp );
+}
+
+} //namespace imageshrink
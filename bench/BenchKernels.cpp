@@ -0,0 +1,107 @@
+
+// include system headers
+#include <string>
+
+// include own headers
+#include "Benchmark.h"
+
+// include application headers
+#include "ImageAverage.h"
+#include "ImageCollection.h"
+#include "ImageCovariance.h"
+#include "ImageDSSIM.h"
+#include "ImageJfif.h"
+#include "ImageReferenceContext.h"
+#include "ImageStatistics.h"
+#include "ImageVariance.h"
+#include "SyntheticImage.h"
+
+namespace imageshrink
+{
+
+void benchKernels( const BenchmarkSettings & settings )
+{
+    const double megaPixels = settings.width * static_cast<double>( settings.height ) / 1.0e6;
+    const int averaging = 8;
+    const int quality = 85;
+    const std::string cs = ChrominanceSubsampling::toString( settings.cs );
+
+    SyntheticImage original( settings.width, settings.height, settings.cs, 1 );
+    SyntheticImage candidate( settings.width, settings.height, settings.cs, 2 );
+
+    // the kernels of the pixel engine on 8x8 chunks
+    ImageInterfaceShrdPtr originalAverage  = std::make_shared<ImageAverage>( original, averaging );
+    ImageInterfaceShrdPtr candidateAverage = std::make_shared<ImageAverage>( candidate, averaging );
+
+    const Measurement measurementAverage = measure( [&]()
+    {
+        ImageAverage average( original, averaging );
+    }, settings.repetitions );
+
+    const Measurement measurementVariance = measure( [&]()
+    {
+        ImageVariance variance( original, *originalAverage, averaging );
+    }, settings.repetitions );
+
+    const Measurement measurementCovariance = measure( [&]()
+    {
+        ImageCovariance covariance( original, *originalAverage, candidate, *candidateAverage, averaging );
+    }, settings.repetitions );
+
+    report( "kernel average", cs + ", 8x8 chunks", megaPixels, measurementAverage );
+    report( "kernel variance", cs + ", 8x8 chunks", megaPixels, measurementVariance );
+    report( "kernel covariance", cs + ", 8x8 chunks", megaPixels, measurementCovariance );
+
+    // DSSIM of the images with their averages and variances (contains the covariance)
+    ImageCollection collection1;
+    ImageCollection collection2;
+
+    collection1.addImage( "original", std::make_shared<ImageJfif>( original ) );
+    collection1.addImage( "average",  originalAverage );
+    collection1.addImage( "variance", std::make_shared<ImageVariance>( original, *originalAverage, averaging ) );
+    collection2.addImage( "original", std::make_shared<ImageJfif>( candidate ) );
+    collection2.addImage( "average",  candidateAverage );
+    collection2.addImage( "variance", std::make_shared<ImageVariance>( candidate, *candidateAverage, averaging ) );
+
+    const Measurement measurementImages = measure( [&]()
+    {
+        ImageDSSIM imageDSSIM( collection1, collection2, averaging );
+    }, settings.repetitions );
+
+    // DSSIM of the search: chunk statistics of a candidate against the known original
+    ImageReferenceContext reference( original, 160 );
+    ImageStatistics statistics( reference, candidate );
+
+    const Measurement measurementStatistics = measure( [&]()
+    {
+        ImageStatistics statistics( reference, candidate );
+    }, settings.repetitions );
+
+    const Measurement measurementDSSIM = measure( [&]()
+    {
+        ImageDSSIM imageDSSIM( statistics );
+    }, settings.repetitions );
+
+    report( "kernel dssim images", cs + ", 8x8 chunks", megaPixels, measurementImages );
+    report( "kernel statistics", cs + ", 160x160 chunks", megaPixels, measurementStatistics );
+    report( "kernel dssim statistics", cs + ", 160x160 chunks", megaPixels, measurementDSSIM );
+
+    // TurboJPEG at the subsampling of the image (no chroma conversion)
+    ImageJfif jfif( original );
+    ImageBufferShrdPtr compressed = jfif.getCompressedImage( quality, settings.cs );
+
+    const Measurement measurementCompress = measure( [&]()
+    {
+        jfif.getCompressedImage( quality, settings.cs );
+    }, settings.repetitions );
+
+    const Measurement measurementDecompress = measure( [&]()
+    {
+        ImageJfif decompressed( compressed );
+    }, settings.repetitions );
+
+    report( "kernel compress", cs + ", quality 85", megaPixels, measurementCompress );
+    report( "kernel decompress", cs + ", quality 85", megaPixels, measurementDecompress );
+}
+
+} //namespace imageshrink
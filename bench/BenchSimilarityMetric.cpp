@@ -0,0 +1,112 @@
+
+// include system headers
+#include <vector>
+
+// include own headers
+#include "Benchmark.h"
+
+// include application headers
+#include "GaussianFilter.h"
+#include "GaussianSSIM.h"
+#include "ImageDSSIM.h"
+#include "ImageReferenceContext.h"
+#include "ImageStatistics.h"
+#include "MultiScaleSSIM.h"
+#include "SyntheticImage.h"
+
+namespace imageshrink
+{
+
+void benchSimilarityMetric( const BenchmarkSettings & settings )
+{
+    const double megaPixels = settings.width * static_cast<double>( settings.height ) / 1.0e6;
+    const int averaging = 160;
+
+    SyntheticImage original( settings.width, settings.height, ChrominanceSubsampling::CS_420, 1 );
+    SyntheticImage candidate( settings.width, settings.height, ChrominanceSubsampling::CS_420, 2 );
+
+    ImageReferenceContextShrdPtr reference = std::make_shared<ImageReferenceContext>( original, averaging );
+
+    // line kernels of every implementation (11 taps, one line of the image)
+    std::vector<float> weights( GaussianSSIM::nofTaps );
+    calcGaussianWeights( weights.data(), GaussianSSIM::nofTaps, 1.5 );
+
+    std::vector<float> in( settings.width + GaussianSSIM::nofTaps, 1.0f );
+    std::vector<float> out( settings.width );
+    std::vector<const float *> columns( GaussianSSIM::nofTaps, in.data() );
+
+    for( int i = 0; i < getNofGaussianFilterImplementations(); ++i )
+    {
+        const GaussianFilterImplementation & implementation = getGaussianFilterImplementation( i );
+
+        const Measurement measurementLine = measure( [&]()
+        {
+            for( int y = 0; y < settings.height; ++y )
+            {
+                implementation.filterLine( in.data(), weights.data(), GaussianSSIM::nofTaps, out.data(), settings.width );
+            }
+        }, settings.repetitions );
+
+        const Measurement measurementColumns = measure( [&]()
+        {
+            for( int y = 0; y < settings.height; ++y )
+            {
+                implementation.filterColumns( columns.data(), weights.data(), GaussianSSIM::nofTaps, out.data(), settings.width );
+            }
+        }, settings.repetitions );
+
+        report( "gaussian filter lines", implementation.name, megaPixels, measurementLine );
+        report( "gaussian filter columns", implementation.name, megaPixels, measurementColumns );
+    }
+
+    // one candidate compared against the original (reference known already)
+    const Measurement measurementBlock = measure( [&]()
+    {
+        ImageStatistics statistics( *reference, candidate );
+        ImageDSSIM imageDSSIM( statistics );
+    }, settings.repetitions );
+
+    // all planes in one pass over the chunk lines
+    std::vector<ImageReferenceContextShrdPtr> planeReferences;
+
+    for( int plane = 0; plane < 3; ++plane )
+    {
+        planeReferences.push_back( std::make_shared<ImageReferenceContext>( original, averaging, plane ) );
+    }
+
+    const Measurement measurementPlanes = measure( [&]()
+    {
+        std::vector<ImageStatistics> statistics = ImageStatistics::calcPlaneStatistics( planeReferences, candidate );
+
+        for( std::size_t i = 0; i < statistics.size(); ++i )
+        {
+            ImageDSSIM imageDSSIM( statistics[i] );
+        }
+    }, settings.repetitions );
+
+    GaussianSSIM gaussianSSIM( reference );
+
+    const Measurement measurementGaussian = measure( [&]()
+    {
+        double dssim = 0.0;
+        double dssimPeak = 0.0;
+        gaussianSSIM.compare( candidate, dssim, dssimPeak );
+    }, settings.repetitions );
+
+    // without limits, so all scales are evaluated
+    MultiScaleSSIM multiScaleSSIM( original, averaging );
+
+    const Measurement measurementMultiScale = measure( [&]()
+    {
+        double dssim = 0.0;
+        double dssimPeak = 0.0;
+        multiScaleSSIM.compare( candidate, 1.0, 1.0, dssim, dssimPeak );
+    }, settings.repetitions );
+
+    report( "metric block", "160x160 chunks", megaPixels, measurementBlock );
+    report( "metric block Y+Cb+Cr", "160x160 chunks", megaPixels, measurementPlanes );
+    report( "metric gaussian", getGaussianFilter().name, megaPixels, measurementGaussian );
+    report( "metric msssim", "5 scales", megaPixels, measurementMultiScale );
+}
+
+} //namespace imageshrink
@@ -0,0 +1,103 @@
+
+// include system headers
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <omp.h>
+
+// include own headers
+#include "Benchmark.h"
+
+// include application headers
+#include "ImageAverage.h"
+#include "ImageCovariance.h"
+#include "ImageDSSIM.h"
+#include "ImageJfif.h"
+#include "ImageReferenceContext.h"
+#include "ImageStatistics.h"
+#include "ImageVariance.h"
+#include "SyntheticImage.h"
+
+namespace imageshrink
+{
+
+// one kernel with 1, 2, 4, ... threads up to maxThreads; the speedup is
+// relative to one thread
+static void benchScaling( const BenchmarkSettings & settings, int maxThreads, const std::string & benchmark, const std::function<void()> & run )
+{
+    const double megaPixels = settings.width * static_cast<double>( settings.height ) / 1.0e6;
+
+    std::vector<int> threadCounts;
+
+    for( int nofThreads = 1; nofThreads < maxThreads; nofThreads *= 2 )
+    {
+        threadCounts.push_back( nofThreads );
+    }
+
+    threadCounts.push_back( maxThreads );
+
+    double secondsOneThread = 0.0;
+
+    for( auto it = threadCounts.begin(); it != threadCounts.end(); ++it )
+    {
+        omp_set_num_threads( *it );
+
+        const Measurement measurement = measure( run, settings.repetitions );
+
+        if( *it == 1 )
+        {
+            secondsOneThread = measurement.seconds;
+        }
+
+        std::ostringstream variant;
+        variant << *it << " threads (" << std::fixed << std::setprecision( 1 ) << secondsOneThread / measurement.seconds << "x)";
+
+        report( benchmark, variant.str(), megaPixels, measurement );
+    }
+}
+
+void benchThreadScaling( const BenchmarkSettings & settings )
+{
+    // OMP_NUM_THREADS resp. the number of processors
+    const int maxThreads = omp_get_max_threads();
+    const int averaging = 8;
+
+    SyntheticImage original( settings.width, settings.height, ChrominanceSubsampling::CS_420, 1 );
+    SyntheticImage candidate( settings.width, settings.height, ChrominanceSubsampling::CS_420, 2 );
+    SyntheticImage image444( settings.width, settings.height, ChrominanceSubsampling::CS_444 );
+
+    ImageJfif jfif444( image444 );
+    ImageAverage originalAverage( original, averaging );
+    ImageAverage candidateAverage( candidate, averaging );
+    ImageReferenceContextShrdPtr reference = std::make_shared<ImageReferenceContext>( original, 160 );
+
+    benchScaling( settings, maxThreads, "scaling average", [&]()
+    {
+        ImageAverage average( original, averaging );
+    } );
+
+    benchScaling( settings, maxThreads, "scaling variance", [&]()
+    {
+        ImageVariance variance( original, originalAverage, averaging );
+    } );
+
+    benchScaling( settings, maxThreads, "scaling covariance", [&]()
+    {
+        ImageCovariance covariance( original, originalAverage, candidate, candidateAverage, averaging );
+    } );
+
+    benchScaling( settings, maxThreads, "scaling image 444to420", [&]()
+    {
+        jfif444.getImageWithChrominanceSubsampling( ChrominanceSubsampling::CS_420 );
+    } );
+
+    benchScaling( settings, maxThreads, "scaling metric block", [&]()
+    {
+        ImageStatistics statistics( *reference, candidate );
+        ImageDSSIM imageDSSIM( statistics );
+    } );
+
+    omp_set_num_threads( maxThreads );
+}
+
+} //namespace imageshrink
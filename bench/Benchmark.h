@@ -0,0 +1,60 @@
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+// include system headers
+#include <functional>
+#include <string>
+
+// include application headers
+#include "enumChrominanceSubsampling.h"
+
+namespace imageshrink
+{
+
+struct BenchmarkSettings
+{
+    BenchmarkSettings()
+    : width( 4000 )
+    , height( 3000 )
+    , repetitions( 10 )
+    , cs( ChrominanceSubsampling::CS_420 )
+    , csvFile()
+    , jsonFile()
+    {
+        // nothing
+    }
+
+    int width;          // of the synthetic images
+    int height;
+    int repetitions;    // the fastest run counts
+    ChrominanceSubsampling::VALUE cs;   // of the synthetic images of the kernels
+
+    std::string csvFile;    // empty: no CSV output
+    std::string jsonFile;   // empty: no JSON output
+};
+
+// one measurement; the allocations are the means over all runs
+struct Measurement
+{
+    double seconds;          // of the fastest run
+    double nofAllocations;   // newly allocated image buffers per run
+    double bytesAllocated;   // per run
+    double nofBuffers;       // image buffers requested from the pool per run
+};
+
+// runs a function several times (allocations are counted in the calling thread only)
+Measurement measure( const std::function<void()> & run, int repetitions );
+
+// prints one result line and keeps the result for the CSV and JSON output
+void report( const std::string & benchmark, const std::string & variant, double megaPixels, const Measurement & measurement );
+
+// benchmarks
+void benchKernels( const BenchmarkSettings & settings );
+void benchChromaResampling( const BenchmarkSettings & settings );
+void benchSimilarityMetric( const BenchmarkSettings & settings );
+void benchThreadScaling( const BenchmarkSettings & settings );
+
+} //namespace imageshrink
+
+#endif //BENCHMARK_H_
@@ -0,0 +1,130 @@
+
+// include system headers
+#include <algorithm>    // std::min, std::fill
+#include <cmath>
+#include <random>
+#include <vector>
+
+// include own headers
+#include "SyntheticImage.h"
+
+// include application headers
+#include "PlanarImageCalc.h"
+
+namespace imageshrink
+{
+
+static inline unsigned char clampToByte( int value )
+{
+    return ( value < 0 ) ? 0 : ( ( value > 255 ) ? 255 : value );
+}
+
+static void generateGradient( unsigned char * plane, int p, int width, int height, int stride, std::mt19937 & generator )
+{
+    std::uniform_int_distribution<int> noise( -8, 8 );
+
+    for( int y = 0; y < height; ++y )
+    {
+        for( int x = 0; x < stride; ++x )
+        {
+            const int gradient = ( x < width ) ? ( ( 64 * p + x + y ) & 0xFF ) : 0;
+
+            plane[ y * stride + x ] = clampToByte( gradient + noise( generator ) );
+        }
+    }
+}
+
+static void generatePhoto( unsigned char * plane, int p, int width, int height, int stride, std::mt19937 & generator )
+{
+    // the chroma planes carry less structure and less noise than the luminance
+    const double amplitude = ( p == 0 ) ? 1.0 : 0.4;
+    std::uniform_real_distribution<double> uniform( 0.0, 1.0 );
+    std::uniform_int_distribution<int> noise( ( p == 0 ) ? -24 : -6, ( p == 0 ) ? 24 : 6 );
+
+    // separable waves of a coarse and a fine scale relative to the image size
+    std::vector<double> columns( stride );
+    std::vector<double> lines( height );
+
+    const double frequencyX1 = 2.0 * M_PI * ( 1.0 + 3.0 * uniform( generator ) ) / std::max( width, 1 );
+    const double frequencyY1 = 2.0 * M_PI * ( 1.0 + 3.0 * uniform( generator ) ) / std::max( height, 1 );
+    const double frequencyX2 = 2.0 * M_PI / ( 6.0 + 20.0 * uniform( generator ) );
+    const double frequencyY2 = 2.0 * M_PI / ( 6.0 + 20.0 * uniform( generator ) );
+    const double phase = 2.0 * M_PI * uniform( generator );
+
+    for( int x = 0; x < stride; ++x )
+    {
+        columns[x] = 70.0 * std::sin( frequencyX1 * x + phase ) + 25.0 * std::sin( frequencyX2 * x );
+    }
+
+    for( int y = 0; y < height; ++y )
+    {
+        lines[y] = 70.0 * std::cos( frequencyY1 * y ) + 25.0 * std::cos( frequencyY2 * y + phase );
+    }
+
+    for( int y = 0; y < height; ++y )
+    {
+        for( int x = 0; x < stride; ++x )
+        {
+            const double value = 128.0 + amplitude * 0.5 * ( columns[x] + lines[y] );
+
+            plane[ y * stride + x ] = clampToByte( static_cast<int>( value ) + noise( generator ) );
+        }
+    }
+}
+
+static void generateGraphics( unsigned char * plane, int p, int width, int height, int stride, std::mt19937 & generator )
+{
+    std::uniform_int_distribution<int> color( 0, 255 );
+    std::uniform_real_distribution<double> uniform( 0.0, 1.0 );
+
+    std::fill( plane, plane + stride * height, static_cast<unsigned char>( ( p == 0 ) ? 235 : 128 ) );
+
+    // the rectangles are painted over each other; their sizes are relative to the image
+    const int nofRectangles = 48;
+
+    for( int i = 0; i < nofRectangles; ++i )
+    {
+        const int x0 = static_cast<int>( uniform( generator ) * width );
+        const int y0 = static_cast<int>( uniform( generator ) * height );
+        const int x1 = std::min( width,  x0 + 1 + static_cast<int>( uniform( generator ) * width / 3 ) );
+        const int y1 = std::min( height, y0 + 1 + static_cast<int>( uniform( generator ) * height / 3 ) );
+        const unsigned char value = color( generator );
+
+        for( int y = y0; y < y1; ++y )
+        {
+            std::fill( &plane[ y * stride + x0 ], &plane[ y * stride + x1 ], value );
+        }
+    }
+}
+
+SyntheticImage::SyntheticImage( int width, int height, ChrominanceSubsampling::VALUE cs, unsigned int seed, Pattern pattern )
+: m_chrominanceSubsampling( cs )
+, m_imageBuffer()
+, m_width( width )
+, m_height( height )
+{
+    const PlanarImageDesc desc = calcPlanaerImageDescForYUV( width, height, cs, TJ_PAD );
+
+    m_imageBuffer = std::make_shared<ImageBuffer>( desc.bufferSize );
+
+    std::mt19937 generator( seed );
+
+    const int widths[3]  = { desc.width0,  desc.width1,  desc.width2 };
+    const int heights[3] = { desc.height0, desc.height1, desc.height2 };
+    const int strides[3] = { desc.stride0, desc.stride1, desc.stride2 };
+    unsigned char * plane = m_imageBuffer->image;
+
+    for( int p = 0; p < 3; ++p )
+    {
+        switch( pattern )
+        {
+            case PHOTO:    generatePhoto( plane, p, widths[p], heights[p], strides[p], generator ); break;
+            case GRAPHICS: generateGraphics( plane, p, widths[p], heights[p], strides[p], generator ); break;
+            default:       generateGradient( plane, p, widths[p], heights[p], strides[p], generator ); break;
+        }
+
+        plane += strides[p] * heights[p];
+    }
+}
+
+} //namespace imageshrink
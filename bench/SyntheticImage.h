@@ -0,0 +1,73 @@
+
+#ifndef SYNTHETICIMAGE_H_
+#define SYNTHETICIMAGE_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "ImageInterface.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class SyntheticImage;
+typedef std::shared_ptr<SyntheticImage> SyntheticImageShrdPtr;
+typedef std::weak_ptr<SyntheticImage>   SyntheticImageWkPtr;
+
+// declaration
+// planar YCbCr image with reproducible content
+class SyntheticImage
+: public ImageInterface
+{
+    //********** PRELIMINARY **********
+    public:
+        enum Pattern
+        {
+            GRADIENT,   // slightly noisy gradients
+            PHOTO,      // smooth structures of several scales with strong noise
+            GRAPHICS    // flat rectangles with sharp edges, no noise
+        };
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        SyntheticImage( int width, int height, ChrominanceSubsampling::VALUE cs, unsigned int seed = 1, Pattern pattern = GRADIENT );
+        virtual ~SyntheticImage() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        ChrominanceSubsampling::VALUE m_chrominanceSubsampling;
+        ImageBufferShrdPtr            m_imageBuffer;
+        int                           m_width;
+        int                           m_height;
+
+    //********** METHODS **********
+    public:
+        virtual PixelFormat::VALUE getPixelFormat() const { return PixelFormat::YCbCr_Planar; }
+        virtual Colorspace::VALUE getColorspace() const { return Colorspace::YCbCr; }
+        virtual BitsPerPixelAndChannel::VALUE getBitsPerPixelAndChannel() const { return BitsPerPixelAndChannel::BITS_8; }
+        virtual ChrominanceSubsampling::VALUE getChrominanceSubsampling() const { return m_chrominanceSubsampling; }
+        virtual ImageBufferShrdPtr getImageBuffer() const { return m_imageBuffer; }
+        virtual int getWidth() const { return m_width; }
+        virtual int getHeight() const { return m_height; }
+        virtual bool isImageValid() const { return static_cast<bool>(m_imageBuffer); }
+        virtual void reset() { m_imageBuffer.reset(); }
+
+    protected:
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //SYNTHETICIMAGE_H_
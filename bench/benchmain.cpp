@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include "Benchmark.h"
+#include "StatsRecord.h"
+
+namespace imageshrink
+{
+
+// one reported line
+struct BenchmarkResult
+{
+    std::string benchmark;
+    std::string variant;
+    double      megaPixels;
+    Measurement measurement;
+};
+
+static std::vector<BenchmarkResult> results;
+
+Measurement measure( const std::function<void()> & run, int repetitions )
+{
+    Measurement ret;
+    double best = 0.0;
+
+    // the image buffers are counted like with --stats json
+    StatsRecord record;
+
+    {
+        StatsScope scope( &record );
+
+        for( int i = 0; i < repetitions; ++i )
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            run();
+            const std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+            const double seconds = std::chrono::duration<double>( stop - start ).count();
+
+            if( ( i == 0 ) || ( seconds < best ) )
+            {
+                best = seconds;
+            }
+        }
+    }
+
+    ret.seconds        = best;
+    ret.nofAllocations = record.getNofAllocations() / static_cast<double>( repetitions );
+    ret.bytesAllocated = record.getBytesAllocated() / static_cast<double>( repetitions );
+    ret.nofBuffers     = ( record.getNofPoolHits() + record.getNofPoolMisses() ) / static_cast<double>( repetitions );
+
+    return ret;
+}
+
+void report( const std::string & benchmark, const std::string & variant, double megaPixels, const Measurement & measurement )
+{
+    BenchmarkResult result;
+
+    result.benchmark   = benchmark;
+    result.variant     = variant;
+    result.megaPixels  = megaPixels;
+    result.measurement = measurement;
+
+    results.push_back( result );
+
+    std::cout << std::left
+              << std::setw( 28 ) << benchmark
+              << std::setw( 28 ) << variant
+              << std::right << std::fixed << std::setprecision( 1 )
+              << std::setw( 10 ) << megaPixels / measurement.seconds << " MPix/s"
+              << std::setprecision( 2 )
+              << std::setw( 10 ) << measurement.seconds * 1.0e3 / megaPixels << " ns/pixel"
+              << std::setprecision( 1 )
+              << std::setw( 8 ) << measurement.nofAllocations << " allocs"
+              << std::setw( 8 ) << measurement.nofBuffers << " buffers"
+              << std::endl;
+}
+
+// quoted like RFC 4180
+static std::string toCsvField( const std::string & value )
+{
+    std::string ret = "\"";
+
+    for( auto it = value.begin(); it != value.end(); ++it )
+    {
+        ret += ( *it == '"' ) ? "\"\"" : std::string( 1, *it );
+    }
+
+    return ret + "\"";
+}
+
+static bool writeCsv( const std::string & path )
+{
+    std::ofstream ofs( path.c_str() );
+
+    if( !ofs )
+    {
+        return false;
+    }
+
+    ofs << "benchmark,variant,megapixels,seconds,mpix_per_s,ns_per_pixel,allocations,allocated_bytes,buffers" << std::endl;
+
+    for( auto it = results.begin(); it != results.end(); ++it )
+    {
+        const Measurement & m = it->measurement;
+
+        ofs << toCsvField( it->benchmark ) << ","
+            << toCsvField( it->variant ) << ","
+            << std::setprecision( 6 ) << it->megaPixels << ","
+            << std::setprecision( 9 ) << m.seconds << ","
+            << std::setprecision( 6 ) << it->megaPixels / m.seconds << ","
+            << m.seconds * 1.0e3 / it->megaPixels << ","
+            << m.nofAllocations << ","
+            << m.bytesAllocated << ","
+            << m.nofBuffers
+            << std::endl;
+    }
+
+    return static_cast<bool>( ofs );
+}
+
+static bool writeJson( const std::string & path, const BenchmarkSettings & settings )
+{
+    std::ofstream ofs( path.c_str() );
+
+    if( !ofs )
+    {
+        return false;
+    }
+
+    ofs << "{\"width\":" << settings.width
+        << ",\"height\":" << settings.height
+        << ",\"subsampling\":\"" << ChrominanceSubsampling::toString( settings.cs ) << "\""
+        << ",\"repetitions\":" << settings.repetitions
+        << ",\"threads\":" << omp_get_max_threads()
+        << ",\"results\":[" << std::endl;
+
+    for( auto it = results.begin(); it != results.end(); ++it )
+    {
+        const Measurement & m = it->measurement;
+
+        ofs << "{\"benchmark\":";
+        StatsRecord::writeJsonString( ofs, it->benchmark );
+        ofs << ",\"variant\":";
+        StatsRecord::writeJsonString( ofs, it->variant );
+        ofs << ",\"megapixels\":" << std::setprecision( 6 ) << it->megaPixels
+            << ",\"seconds\":" << std::setprecision( 9 ) << m.seconds
+            << ",\"mpixPerSecond\":" << std::setprecision( 6 ) << it->megaPixels / m.seconds
+            << ",\"nsPerPixel\":" << m.seconds * 1.0e3 / it->megaPixels
+            << ",\"allocations\":" << m.nofAllocations
+            << ",\"allocatedBytes\":" << m.bytesAllocated
+            << ",\"buffers\":" << m.nofBuffers
+            << "}" << ( ( it + 1 != results.end() ) ? "," : "" ) << std::endl;
+    }
+
+    ofs << "]}" << std::endl;
+
+    return static_cast<bool>( ofs );
+}
+
+} //namespace imageshrink
+
+static void printUsage()
+{
+    std::cout << "imageshrink_bench [settings] [benchmark ...]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "settings:" << std::endl;
+    std::cout << "    --width value               width of the synthetic images (default = 4000)" << std::endl;
+    std::cout << "    --height value              height of the synthetic images (default = 3000)" << std::endl;
+    std::cout << "    --repetitions value         runs per measurement; the fastest counts (default = 10)" << std::endl;
+    std::cout << "    --cs value                  chrominance subsampling of the images of the kernels (value = 444|422|420, default = 420)" << std::endl;
+    std::cout << "    --csv file                  write the results as CSV" << std::endl;
+    std::cout << "    --json file                 write the results as JSON" << std::endl;
+    std::cout << std::endl;
+    std::cout << "benchmarks (default = all):" << std::endl;
+    std::cout << "    kernels                     average, variance, covariance, DSSIM, compress and decompress" << std::endl;
+    std::cout << "    chroma                      4:4:4 <-> 4:2:0 chroma conversion" << std::endl;
+    std::cout << "    metric                      block DSSIM vs. Gaussian SSIM vs. MS-SSIM of one candidate" << std::endl;
+    std::cout << "    scaling                     per plane kernels and block DSSIM with 1 .. OMP_NUM_THREADS threads" << std::endl;
+}
+
+int main( int argc, const char* argv[] )
+{
+    imageshrink::BenchmarkSettings settings;
+    std::vector<std::string> benchmarks;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+
+        if(    ( ( arg == "--width" ) || ( arg == "--height" ) || ( arg == "--repetitions" ) )
+            && ( ( i + 1 ) < argc )
+          )
+        {
+            int value = 0;
+
+            try {
+                value = std::stoi( argv[ ++i ] );
+            } catch (...) {
+                value = 0;
+            }
+
+            if( value <= 0 )
+            {
+                std::cerr << "invalid value for " << arg << std::endl;
+                return 1;
+            }
+
+            if( arg == "--width" )       settings.width = value;
+            if( arg == "--height" )      settings.height = value;
+            if( arg == "--repetitions" ) settings.repetitions = value;
+        }
+        else if(    ( arg == "--cs" )
+                 && ( ( i + 1 ) < argc )
+               )
+        {
+            const std::string value = argv[ ++i ];
+
+            if( value == "444" )      settings.cs = ChrominanceSubsampling::CS_444;
+            else if( value == "422" ) settings.cs = ChrominanceSubsampling::CS_422;
+            else if( value == "420" ) settings.cs = ChrominanceSubsampling::CS_420;
+            else
+            {
+                std::cerr << "invalid value for " << arg << std::endl;
+                return 1;
+            }
+        }
+        else if(    ( ( arg == "--csv" ) || ( arg == "--json" ) )
+                 && ( ( i + 1 ) < argc )
+               )
+        {
+            if( arg == "--csv" )  settings.csvFile = argv[ ++i ];
+            if( arg == "--json" ) settings.jsonFile = argv[ ++i ];
+        }
+        else if( ( arg == "--help" ) || ( arg == "-h" ) )
+        {
+            printUsage();
+            return 0;
+        }
+        else if( arg.compare( 0, 2, "--" ) == 0 )
+        {
+            std::cerr << "unknown setting " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+        else
+        {
+            benchmarks.push_back( arg );
+        }
+    }
+
+    const bool all = benchmarks.empty();
+
+    for( auto it = benchmarks.begin(); it != benchmarks.end(); ++it )
+    {
+        if(    ( *it != "kernels" )
+            && ( *it != "chroma" )
+            && ( *it != "metric" )
+            && ( *it != "scaling" )
+          )
+        {
+            std::cerr << "unknown benchmark " << *it << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "image size " << settings.width << " x " << settings.height
+              << ", best of " << settings.repetitions << " runs" << std::endl;
+
+    if( all || ( std::find( benchmarks.begin(), benchmarks.end(), "kernels" ) != benchmarks.end() ) )
+    {
+        imageshrink::benchKernels( settings );
+    }
+
+    if( all || ( std::find( benchmarks.begin(), benchmarks.end(), "chroma" ) != benchmarks.end() ) )
+    {
+        imageshrink::benchChromaResampling( settings );
+    }
+
+    if( all || ( std::find( benchmarks.begin(), benchmarks.end(), "metric" ) != benchmarks.end() ) )
+    {
+        imageshrink::benchSimilarityMetric( settings );
+    }
+
+    if( all || ( std::find( benchmarks.begin(), benchmarks.end(), "scaling" ) != benchmarks.end() ) )
+    {
+        imageshrink::benchThreadScaling( settings );
+    }
+
+    if(    ( !settings.csvFile.empty() )
+        && ( !imageshrink::writeCsv( settings.csvFile ) )
+      )
+    {
+        std::cerr << "CSV file " << settings.csvFile << " could not be written" << std::endl;
+        return 1;
+    }
+
+    if(    ( !settings.jsonFile.empty() )
+        && ( !imageshrink::writeJson( settings.jsonFile, settings ) )
+      )
+    {
+        std::cerr << "JSON file " << settings.jsonFile << " could not be written" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
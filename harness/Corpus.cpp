@@ -0,0 +1,122 @@
+
+// include system headers
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// include own headers
+#include "Corpus.h"
+
+// include application headers
+#include "ImageJfif.h"
+#include "SyntheticImage.h"
+
+namespace imageshrink
+{
+
+struct CorpusSize
+{
+    const char * name;
+    int          width;
+    int          height;
+};
+
+static const CorpusSize sizes[] =
+{
+    { "thumbnail", 160,  120 },
+    { "vga",       640,  480 },
+    { "2mp",       1920, 1080 },
+    { "12mp",      4000, 3000 },
+    { "50mp",      8192, 6144 }
+};
+
+static const int inputQuality = 92;
+
+static bool writeImage( const std::string & path, int width, int height, ChrominanceSubsampling::VALUE cs,
+                        unsigned int seed, SyntheticImage::Pattern pattern )
+{
+    SyntheticImage image( width, height, cs, seed, pattern );
+    ImageJfif jfif( image );
+
+    ImageBufferShrdPtr compressed = jfif.getCompressedImage( inputQuality, cs );
+
+    if( !compressed )
+    {
+        return false;
+    }
+
+    std::ofstream ofs( path.c_str(), std::ofstream::out | std::ofstream::binary );
+    ofs.write( reinterpret_cast<const char*>( compressed->image ), compressed->size );
+
+    return static_cast<bool>( ofs );
+}
+
+std::vector<CorpusImage> generateCorpus( const std::string & directory, double maxMegaPixels )
+{
+    std::vector<CorpusImage> ret;
+
+    if(    ( mkdir( directory.c_str(), 0755 ) != 0 )
+        && ( errno != EEXIST )
+      )
+    {
+        std::cerr << "directory " << directory << " could not be created" << std::endl;
+        return ret;
+    }
+
+    const SyntheticImage::Pattern patterns[] = { SyntheticImage::PHOTO, SyntheticImage::GRAPHICS };
+    const char * const patternNames[] = { "photo", "graphics" };
+
+    const ChrominanceSubsampling::VALUE subsamplings[] = { ChrominanceSubsampling::CS_444, ChrominanceSubsampling::CS_422, ChrominanceSubsampling::CS_420 };
+    const char * const subsamplingNames[] = { "444", "422", "420" };
+
+    const int nofSizes = sizeof( sizes ) / sizeof( sizes[0] );
+
+    for( int i = 0; i < nofSizes; ++i )
+    {
+        const CorpusSize & size = sizes[i];
+
+        if( size.width * static_cast<double>( size.height ) / 1.0e6 > maxMegaPixels )
+        {
+            continue;
+        }
+
+        for( int p = 0; p < 2; ++p )
+        {
+            for( int s = 0; s < 3; ++s )
+            {
+                // the content of an image does not depend on the other images
+                const unsigned int seed = 1 + ( i * 2 + p ) * 3 + s;
+
+                CorpusImage image;
+
+                std::ostringstream name;
+                name << patternNames[p] << "_" << subsamplingNames[s] << "_" << size.name;
+
+                image.name   = name.str();
+                image.path   = directory + "/" + image.name + ".jpg";
+                image.width  = size.width;
+                image.height = size.height;
+
+                struct stat fileStat;
+
+                if(    ( stat( image.path.c_str(), &fileStat ) != 0 )
+                    && ( !writeImage( image.path, size.width, size.height, subsamplings[s], seed, patterns[p] ) )
+                  )
+                {
+                    std::cerr << "corpus image " << image.path << " could not be written" << std::endl;
+                    return std::vector<CorpusImage>();
+                }
+
+                ret.push_back( image );
+            }
+        }
+    }
+
+    return ret;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,29 @@
+
+#ifndef CORPUS_H_
+#define CORPUS_H_
+
+// include system headers
+#include <string>
+#include <vector>
+
+namespace imageshrink
+{
+
+// one generated JPEG file
+struct CorpusImage
+{
+    std::string path;
+    std::string name;     // pattern, subsampling and size
+    int         width;
+    int         height;
+};
+
+// writes a deterministic set of JPEG files (photo like noise and flat
+// graphics, 4:4:4, 4:2:2 and 4:2:0, thumbnails up to 50 MP) compressed
+// with TurboJPEG into the directory; files which exist already are kept,
+// since they would be the same. Returns an empty list on errors.
+std::vector<CorpusImage> generateCorpus( const std::string & directory, double maxMegaPixels );
+
+} //namespace imageshrink
+
+#endif //CORPUS_H_
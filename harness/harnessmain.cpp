@@ -0,0 +1,415 @@
+#include <stdlib.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <omp.h>
+
+#include "BufferPool.h"
+#include "Corpus.h"
+#include "ImageShrinker.h"
+#include "StatsRecord.h"
+#include "settings.h"
+
+namespace imageshrink
+{
+
+struct HarnessSettings
+{
+    HarnessSettings()
+    : corpusDirectory( "imageshrink_corpus" )
+    , maxMegaPixels( 50.0 )
+    , threads()
+    , searches()
+    , engines()
+    , jsonFile()
+    {
+        // nothing
+    }
+
+    std::string                          corpusDirectory;
+    double                               maxMegaPixels;
+    std::vector<int>                     threads;
+    std::vector<QualitySearch::VALUE>    searches;
+    std::vector<ComparisonEngine::VALUE> engines;
+    std::string                          jsonFile;   // empty: no JSON output
+};
+
+// the whole corpus shrunk with one configuration
+struct HarnessResult
+{
+    int                     threads;
+    QualitySearch::VALUE    search;
+    ComparisonEngine::VALUE engine;
+    int                     nofImages;
+    int                     nofFailures;
+    double                  seconds;
+    double                  megaPixels;
+    double                  encodesPerImage;
+    double                  latencyP50;       // in seconds
+    double                  latencyP99;
+    long long               peakMemory;       // resident set in kB
+};
+
+// peak resident set size of the process in kB; on Linux the peak is
+// reset before every configuration, elsewhere it is the peak since start
+static void resetPeakMemory()
+{
+    std::ofstream ofs( "/proc/self/clear_refs" );
+
+    if( ofs )
+    {
+        ofs << "5";
+    }
+}
+
+static long long getPeakMemory()
+{
+    std::ifstream ifs( "/proc/self/status" );
+    std::string line;
+
+    while( std::getline( ifs, line ) )
+    {
+        if( line.compare( 0, 6, "VmHWM:" ) == 0 )
+        {
+            return std::atoll( line.c_str() + 6 );
+        }
+    }
+
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+    {
+        return 0;
+    }
+
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;   // in bytes
+#else
+    return usage.ru_maxrss;
+#endif //__APPLE__
+}
+
+// nearest rank of sorted values
+static double getPercentile( const std::vector<double> & sortedValues, double percentile )
+{
+    if( sortedValues.empty() )
+    {
+        return 0.0;
+    }
+
+    const int rank = static_cast<int>( std::ceil( percentile / 100.0 * sortedValues.size() ) );
+
+    return sortedValues[ std::max( rank, 1 ) - 1 ];
+}
+
+static HarnessResult runConfiguration( const std::vector<CorpusImage> & corpus, const std::string & outputDirectory,
+                                       int threads, QualitySearch::VALUE search, ComparisonEngine::VALUE engine )
+{
+    HarnessResult ret;
+
+    ret.threads     = threads;
+    ret.search      = search;
+    ret.engine      = engine;
+    ret.nofImages   = 0;
+    ret.nofFailures = 0;
+    ret.seconds     = 0.0;
+    ret.megaPixels  = 0.0;
+
+    Settings settings;
+    settings.threads          = threads;
+    settings.qualitySearch    = search;
+    settings.comparisonEngine = engine;
+
+    omp_set_num_threads( threads );
+
+    // buffers kept from the previous configuration would count as its memory
+    BufferPool::getInstance().clear();
+    resetPeakMemory();
+
+    std::vector<double> latencies;
+    long long nofEncodes = 0;
+
+    ImageShrinker shrinker( settings );
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( auto it = corpus.begin(); it != corpus.end(); ++it )
+    {
+        const std::chrono::steady_clock::time_point imageStart = std::chrono::steady_clock::now();
+        const ShrinkResult result = shrinker.shrink( it->path, outputDirectory + "/" + it->name + ".jpg" );
+        const std::chrono::duration<double> latency = std::chrono::steady_clock::now() - imageStart;
+
+        if( !result.success )
+        {
+            std::cerr << it->path << ": " << result.errorMessage << std::endl;
+            ret.nofFailures++;
+            continue;
+        }
+
+        latencies.push_back( latency.count() );
+        nofEncodes     += result.nofEvaluations;
+        ret.megaPixels += it->width * static_cast<double>( it->height ) / 1.0e6;
+        ret.nofImages++;
+    }
+
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    std::sort( latencies.begin(), latencies.end() );
+
+    ret.seconds         = seconds.count();
+    ret.encodesPerImage = ( ret.nofImages > 0 ) ? nofEncodes / static_cast<double>( ret.nofImages ) : 0.0;
+    ret.latencyP50      = getPercentile( latencies, 50.0 );
+    ret.latencyP99      = getPercentile( latencies, 99.0 );
+    ret.peakMemory      = getPeakMemory();
+
+    return ret;
+}
+
+static void printResult( const HarnessResult & result )
+{
+    std::cout << std::right << std::fixed
+              << std::setw( 4 ) << result.threads << " threads  "
+              << std::left
+              << std::setw( 10 ) << QualitySearch::toString( result.search )
+              << std::setw( 7 ) << ComparisonEngine::toString( result.engine )
+              << std::right << std::setprecision( 2 )
+              << std::setw( 8 ) << result.nofImages / result.seconds << " images/s"
+              << std::setw( 9 ) << result.megaPixels / result.seconds << " MPix/s"
+              << std::setprecision( 1 )
+              << std::setw( 6 ) << result.encodesPerImage << " encodes/image"
+              << "  p50 " << std::setw( 8 ) << result.latencyP50 * 1.0e3 << " ms"
+              << "  p99 " << std::setw( 8 ) << result.latencyP99 * 1.0e3 << " ms"
+              << "  peak RSS " << std::setw( 6 ) << result.peakMemory / 1024 << " MB";
+
+    if( result.nofFailures > 0 )
+    {
+        std::cout << "  (" << result.nofFailures << " failed)";
+    }
+
+    std::cout << std::endl;
+}
+
+static bool writeJson( const std::string & path, const HarnessSettings & settings, int nofImages, const std::vector<HarnessResult> & results )
+{
+    std::ofstream ofs( path.c_str() );
+
+    if( !ofs )
+    {
+        return false;
+    }
+
+    ofs << "{\"corpus\":";
+    StatsRecord::writeJsonString( ofs, settings.corpusDirectory );
+    ofs << ",\"images\":" << nofImages
+        << ",\"maxMegaPixels\":" << settings.maxMegaPixels
+        << ",\"results\":[" << std::endl;
+
+    for( auto it = results.begin(); it != results.end(); ++it )
+    {
+        ofs << "{\"threads\":" << it->threads
+            << ",\"search\":\"" << QualitySearch::toString( it->search ) << "\""
+            << ",\"engine\":\"" << ComparisonEngine::toString( it->engine ) << "\""
+            << ",\"images\":" << it->nofImages
+            << ",\"failures\":" << it->nofFailures
+            << ",\"seconds\":" << std::setprecision( 6 ) << it->seconds
+            << ",\"imagesPerSecond\":" << it->nofImages / it->seconds
+            << ",\"mpixPerSecond\":" << it->megaPixels / it->seconds
+            << ",\"encodesPerImage\":" << it->encodesPerImage
+            << ",\"latencyP50Ms\":" << it->latencyP50 * 1.0e3
+            << ",\"latencyP99Ms\":" << it->latencyP99 * 1.0e3
+            << ",\"peakRssKb\":" << it->peakMemory
+            << "}" << ( ( it + 1 != results.end() ) ? "," : "" ) << std::endl;
+    }
+
+    ofs << "]}" << std::endl;
+
+    return static_cast<bool>( ofs );
+}
+
+} //namespace imageshrink
+
+static void printUsage()
+{
+    std::cout << "imageshrink_harness [settings]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "settings:" << std::endl;
+    std::cout << "    --corpus directory          the generated JPEG files and the outputs (default = imageshrink_corpus)" << std::endl;
+    std::cout << "    --maxMegaPixels value       largest images of the corpus, from 0.02 (thumbnails) to 50 (default = 50)" << std::endl;
+    std::cout << "    --threads list              thread counts, e.g. 1,2,4 (default = OMP_NUM_THREADS or the number of processors)" << std::endl;
+    std::cout << "    --search list               quality searches (value = linear|bisection|secant, default = linear)" << std::endl;
+    std::cout << "    --engine list               comparison engines (value = pixel|dct|strips, default = pixel)" << std::endl;
+    std::cout << "    --json file                 write the results as JSON" << std::endl;
+}
+
+static std::vector<std::string> splitList( const std::string & list )
+{
+    std::vector<std::string> ret;
+    std::istringstream iss( list );
+    std::string element;
+
+    while( std::getline( iss, element, ',' ) )
+    {
+        ret.push_back( element );
+    }
+
+    return ret;
+}
+
+int main( int argc, const char* argv[] )
+{
+    imageshrink::HarnessSettings settings;
+
+    // like imageshrink itself
+    setenv( "TJ_OPTIMIZE", "1", 1 );
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+        bool error = false;
+
+        if( ( arg == "--help" ) || ( arg == "-h" ) )
+        {
+            printUsage();
+            return 0;
+        }
+        else if( ( i + 1 ) >= argc )
+        {
+            error = true;
+        }
+        else if( arg == "--corpus" )
+        {
+            settings.corpusDirectory = argv[ ++i ];
+        }
+        else if( arg == "--maxMegaPixels" )
+        {
+            try {
+                settings.maxMegaPixels = std::stod( argv[ ++i ] );
+            } catch (...) {
+                error = true;
+            }
+        }
+        else if( arg == "--threads" )
+        {
+            const std::vector<std::string> values = splitList( argv[ ++i ] );
+
+            for( auto it = values.begin(); it != values.end(); ++it )
+            {
+                int value = 0;
+
+                try {
+                    value = std::stoi( *it );
+                } catch (...) {
+                    value = 0;
+                }
+
+                if( value <= 0 )
+                {
+                    error = true;
+                }
+
+                settings.threads.push_back( value );
+            }
+        }
+        else if( arg == "--search" )
+        {
+            const std::vector<std::string> values = splitList( argv[ ++i ] );
+
+            for( auto it = values.begin(); it != values.end(); ++it )
+            {
+                if( *it == "linear" )         settings.searches.push_back( QualitySearch::LINEAR );
+                else if( *it == "bisection" ) settings.searches.push_back( QualitySearch::BISECTION );
+                else if( *it == "secant" )    settings.searches.push_back( QualitySearch::SECANT );
+                else                          error = true;
+            }
+        }
+        else if( arg == "--engine" )
+        {
+            const std::vector<std::string> values = splitList( argv[ ++i ] );
+
+            for( auto it = values.begin(); it != values.end(); ++it )
+            {
+                if( *it == "pixel" )       settings.engines.push_back( ComparisonEngine::PIXEL );
+                else if( *it == "dct" )    settings.engines.push_back( ComparisonEngine::DCT );
+                else if( *it == "strips" ) settings.engines.push_back( ComparisonEngine::STRIPS );
+                else                       error = true;
+            }
+        }
+        else if( arg == "--json" )
+        {
+            settings.jsonFile = argv[ ++i ];
+        }
+        else
+        {
+            error = true;
+        }
+
+        if( error )
+        {
+            std::cerr << "invalid setting " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if( settings.threads.empty() )   settings.threads.push_back( omp_get_max_threads() );
+    if( settings.searches.empty() )  settings.searches.push_back( QualitySearch::LINEAR );
+    if( settings.engines.empty() )   settings.engines.push_back( ComparisonEngine::PIXEL );
+
+    std::cout << "generate corpus in " << settings.corpusDirectory << " ..." << std::endl;
+
+    const std::vector<imageshrink::CorpusImage> corpus = imageshrink::generateCorpus( settings.corpusDirectory, settings.maxMegaPixels );
+
+    if( corpus.empty() )
+    {
+        std::cerr << "no corpus images" << std::endl;
+        return 1;
+    }
+
+    const std::string outputDirectory = settings.corpusDirectory + "/out";
+
+    if(    ( mkdir( outputDirectory.c_str(), 0755 ) != 0 )
+        && ( errno != EEXIST )
+      )
+    {
+        std::cerr << "directory " << outputDirectory << " could not be created" << std::endl;
+        return 1;
+    }
+
+    std::cout << corpus.size() << " images" << std::endl;
+
+    std::vector<imageshrink::HarnessResult> results;
+
+    for( auto threads = settings.threads.begin(); threads != settings.threads.end(); ++threads )
+    {
+        for( auto search = settings.searches.begin(); search != settings.searches.end(); ++search )
+        {
+            for( auto engine = settings.engines.begin(); engine != settings.engines.end(); ++engine )
+            {
+                results.push_back( imageshrink::runConfiguration( corpus, outputDirectory, *threads, *search, *engine ) );
+                imageshrink::printResult( results.back() );
+            }
+        }
+    }
+
+    if(    ( !settings.jsonFile.empty() )
+        && ( !imageshrink::writeJson( settings.jsonFile, settings, corpus.size(), results ) )
+      )
+    {
+        std::cerr << "JSON file " << settings.jsonFile << " could not be written" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,387 @@
+
+// include system headers
+#include <algorithm>    // std::sort
+#include <cctype>       // std::tolower
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+
+// include own headers
+#include "BatchProcessor.h"
+
+// include application headers
+#include "BufferPool.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerMain( log4cxx::Logger::getLogger( "main" ) );
+#endif //USE_LOG4CXX
+
+BatchProcessor::BatchProcessor( const Settings & settings, ResultCacheShrdPtr cache )
+: m_settings( settings )
+, m_cache( cache )
+, m_jobs()
+{
+    // nothing
+}
+
+bool BatchProcessor::isJpegFile( const std::string & name )
+{
+    const std::string::size_type dot = name.rfind( '.' );
+
+    if( dot == std::string::npos )
+    {
+        return false;
+    }
+
+    std::string extension = name.substr( dot + 1 );
+    std::transform( extension.begin(), extension.end(), extension.begin(), ::tolower );
+
+    return ( extension == "jpg" ) || ( extension == "jpeg" );
+}
+
+bool BatchProcessor::createParentDirectories( const std::string & path )
+{
+    std::string::size_type pos = path.find( '/', 1 );
+
+    while( pos != std::string::npos )
+    {
+        const std::string directory = path.substr( 0, pos );
+
+        if(    ( mkdir( directory.c_str(), 0755 ) != 0 )
+            && ( errno != EEXIST )
+          )
+        {
+            return false;
+        }
+
+        pos = path.find( '/', pos + 1 );
+    }
+
+    return true;
+}
+
+bool BatchProcessor::addJob( const std::string & inputFile, const std::string & relativePath, const std::string & outputRoot )
+{
+    // the output has to stay below the output root
+    if(    ( relativePath.empty() )
+        || ( relativePath == ".." )
+        || ( relativePath.compare( 0, 3, "../" ) == 0 )
+        || ( relativePath.find( "/../" ) != std::string::npos )
+      )
+    {
+        std::cerr << "skipped: " << inputFile << " (path leaves the output root)" << std::endl;
+        return false;
+    }
+
+    Job job;
+    job.inputFile  = inputFile;
+    job.outputFile = outputRoot + "/" + relativePath;
+    job.inputSize  = ImageShrinker::getFileSize( inputFile );
+
+    m_jobs.push_back( job );
+    return true;
+}
+
+void BatchProcessor::collectDirectory( const std::string & directory, const std::string & relativePath, const std::string & outputRoot )
+{
+    DIR * const dir = opendir( directory.c_str() );
+
+    if( dir == nullptr )
+    {
+        std::cerr << "directory could not be opened: " << directory << std::endl;
+        return;
+    }
+
+    std::vector<std::string> names;
+
+    for( struct dirent * entry = readdir( dir ); entry != nullptr; entry = readdir( dir ) )
+    {
+        const std::string name( entry->d_name );
+
+        if( ( name != "." ) && ( name != ".." ) )
+        {
+            names.push_back( name );
+        }
+    }
+
+    closedir( dir );
+
+    // readdir does not guarantee any order
+    std::sort( names.begin(), names.end() );
+
+    for( const std::string & name : names )
+    {
+        const std::string path     = directory + "/" + name;
+        const std::string relative = relativePath.empty() ? name : relativePath + "/" + name;
+        struct stat fileStat;
+
+        if( stat( path.c_str(), &fileStat ) != 0 )
+        {
+            continue;
+        }
+
+        if( S_ISDIR( fileStat.st_mode ) )
+        {
+            collectDirectory( path, relative, outputRoot );
+        }
+        else if(    ( S_ISREG( fileStat.st_mode ) )
+                 && ( isJpegFile( name ) )
+               )
+        {
+            addJob( path, relative, outputRoot );
+        }
+    }
+}
+
+bool BatchProcessor::collectJobs( const std::string & input, const std::string & outputRoot )
+{
+    struct stat fileStat;
+
+    m_jobs.clear();
+
+    if(    ( input != "-" )
+        && ( stat( input.c_str(), &fileStat ) == 0 )
+        && ( S_ISDIR( fileStat.st_mode ) )
+      )
+    {
+        collectDirectory( input, "", outputRoot );
+        return true;
+    }
+
+    std::ifstream listFile;
+
+    if( input != "-" )
+    {
+        listFile.open( input.c_str() );
+
+        if( !listFile.is_open() )
+        {
+            std::cerr << "file list could not be opened: " << input << std::endl;
+            return false;
+        }
+    }
+
+    std::istream & list = ( input == "-" ) ? std::cin : listFile;
+    std::string line;
+
+    while( std::getline( list, line ) )
+    {
+        // ignore trailing carriage returns and empty lines
+        if( ( !line.empty() ) && ( line[ line.size() - 1 ] == '\r' ) )
+        {
+            line.erase( line.size() - 1 );
+        }
+
+        if( line.empty() )
+        {
+            continue;
+        }
+
+        // absolute paths are mirrored below the output root as well
+        std::string::size_type start = 0;
+
+        while( ( start < line.size() ) && ( line[ start ] == '/' ) )
+        {
+            ++start;
+        }
+
+        while( line.compare( start, 2, "./" ) == 0 )
+        {
+            start += 2;
+        }
+
+        addJob( line, line.substr( start ), outputRoot );
+    }
+
+    return true;
+}
+
+void BatchProcessor::processJob( Job & job, const Settings & settings )
+{
+    if( !createParentDirectories( job.outputFile ) )
+    {
+        job.result.errorMessage = "output directory could not be created";
+    }
+    else
+    {
+        ImageShrinker shrinker( settings, m_cache );
+        job.result = shrinker.shrink( job.inputFile, job.outputFile );
+    }
+
+    #pragma omp critical (batchOutput)
+    {
+        printResult( job );
+    }
+}
+
+void BatchProcessor::printResult( const Job & job ) const
+{
+    if( !job.result.stats.empty() )
+    {
+        std::cout << job.result.stats << std::endl;
+    }
+
+    if( job.result.success )
+    {
+        std::cout << job.inputFile
+                  << ": quality " << job.result.quality
+                  << ", " << job.result.nofEvaluations << " encodes"
+                  << ", " << job.result.inputSize << " -> " << job.result.outputSize << " bytes"
+                  << ( job.result.skipped ? " (skipped)" : ( job.result.fromCache ? " (cached)" : "" ) )
+                  << std::endl;
+    }
+    else
+    {
+        std::cerr << job.inputFile << ": " << job.result.errorMessage << std::endl;
+    }
+}
+
+void BatchProcessor::printSummary( double seconds ) const
+{
+    int       nofImages   = 0;
+    int       nofFailures = 0;
+    int       nofCacheHits = 0;
+    long long inputBytes  = 0;
+    long long outputBytes = 0;
+
+    for( const Job & job : m_jobs )
+    {
+        if( job.result.success )
+        {
+            ++nofImages;
+            inputBytes  += job.result.inputSize;
+            outputBytes += job.result.outputSize;
+        }
+        else
+        {
+            ++nofFailures;
+        }
+
+        if( job.result.fromCache )
+        {
+            ++nofCacheHits;
+        }
+    }
+
+    const double savedBytes = static_cast<double>( inputBytes - outputBytes );
+    const double divisor    = ( seconds > 0.0 ) ? seconds : 1.0;
+
+    std::cout << "images:     " << nofImages << " shrunk, " << nofFailures << " failed" << std::endl;
+    std::cout << "time:       " << seconds << " s" << std::endl;
+    std::cout << "throughput: " << nofImages / divisor << " images/s, "
+              << inputBytes / divisor / 1.0e6 << " MB/s" << std::endl;
+    if( m_cache )
+    {
+        std::cout << "cache:      " << nofCacheHits << " hits" << std::endl;
+    }
+
+    std::cout << "buffers:    " << BufferPool::getInstance().getNofHits() << " reused, "
+              << BufferPool::getInstance().getNofMisses() << " allocated" << std::endl;
+
+    std::cout << "saved:      " << savedBytes << " bytes ("
+              << ( ( inputBytes > 0 ) ? 100.0 * savedBytes / inputBytes : 0.0 ) << " %)" << std::endl;
+}
+
+bool BatchProcessor::run( const std::string & input, const std::string & outputRoot )
+{
+    if( !collectJobs( input, outputRoot ) )
+    {
+        return false;
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // big images first, so that the small ones fill up the gaps at the end
+    std::sort( m_jobs.begin(), m_jobs.end(), []( const Job & a, const Job & b ) { return a.inputSize > b.inputSize; } );
+
+    int nofThreads = 1;
+    long long totalSize = 0;
+
+#ifdef _OPENMP
+    nofThreads = omp_get_max_threads();
+#endif //_OPENMP
+
+    for( const Job & job : m_jobs )
+    {
+        totalSize += std::max( job.inputSize, 0LL );
+    }
+
+    // an image with at least the share of one thread is split internally,
+    // all threads work on it
+    const long long bigJobSize = totalSize / nofThreads;
+    std::size_t nofBigJobs = 0;
+
+    while(    ( nofThreads > 1 )
+           && ( nofBigJobs < m_jobs.size() )
+           && ( m_jobs[ nofBigJobs ].inputSize >= bigJobSize )
+         )
+    {
+        processJob( m_jobs[ nofBigJobs ], m_settings );
+        ++nofBigJobs;
+    }
+
+    // the remaining images are independent tasks; idle threads take the
+    // next one, each image is processed single threaded
+    Settings taskSettings = m_settings;
+
+    if( taskSettings.parallelQualities == 0 )
+    {
+        taskSettings.parallelQualities = 1;
+    }
+
+#ifdef _OPENMP
+    const int maxActiveLevels = omp_get_max_active_levels();
+    omp_set_max_active_levels( 1 );
+#endif //_OPENMP
+
+    #pragma omp parallel
+    {
+        #pragma omp single
+        {
+            for( std::size_t i = nofBigJobs; i < m_jobs.size(); ++i )
+            {
+                #pragma omp task firstprivate( i ) shared( taskSettings )
+                {
+                    processJob( m_jobs[i], taskSettings );
+                }
+            }
+        }
+    }
+
+#ifdef _OPENMP
+    omp_set_max_active_levels( maxActiveLevels );
+#endif //_OPENMP
+
+    const double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    printSummary( seconds );
+
+    for( const Job & job : m_jobs )
+    {
+        if( !job.result.success )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,84 @@
+
+#ifndef BATCHPROCESSOR_H_
+#define BATCHPROCESSOR_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <string>
+#include <vector>
+
+// include application headers
+#include "settings.h"
+#include "ImageShrinker.h"
+#include "ResultCache.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class BatchProcessor;
+typedef std::shared_ptr<BatchProcessor> BatchProcessorShrdPtr;
+typedef std::weak_ptr<BatchProcessor>   BatchProcessorWkPtr;
+
+// declaration
+// shrinks many images in one process; small images run concurrently as
+// OpenMP tasks (work stealing), big images use all threads on their own
+class BatchProcessor
+: public std::enable_shared_from_this<BatchProcessor>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    private:
+        struct Job
+        {
+            std::string  inputFile;
+            std::string  outputFile;
+            long long    inputSize;   // in bytes
+            ShrinkResult result;
+        };
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        BatchProcessor( const Settings & settings, ResultCacheShrdPtr cache = ResultCacheShrdPtr() );
+        virtual ~BatchProcessor() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        Settings           m_settings;
+        ResultCacheShrdPtr m_cache;    // optional
+        std::vector<Job>   m_jobs;
+
+    //********** METHODS **********
+    public:
+        // input is a directory (searched recursively for jpeg files), a file
+        // with one path per line or "-" for such a list on stdin; the relative
+        // paths are kept below outputRoot; returns false if any image failed
+        bool run( const std::string & input, const std::string & outputRoot );
+
+    protected:
+
+    private:
+        bool collectJobs( const std::string & input, const std::string & outputRoot );
+        void collectDirectory( const std::string & directory, const std::string & relativePath, const std::string & outputRoot );
+        bool addJob( const std::string & inputFile, const std::string & relativePath, const std::string & outputRoot );
+        void processJob( Job & job, const Settings & settings );
+        void printResult( const Job & job ) const;
+        void printSummary( double seconds ) const;
+
+        static bool isJpegFile( const std::string & name );
+        static bool createParentDirectories( const std::string & path );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //BATCHPROCESSOR_H_
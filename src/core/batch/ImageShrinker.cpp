@@ -0,0 +1,301 @@
+
+// include system headers
+#include <algorithm>    // std::max
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+// include own headers
+#include "ImageShrinker.h"
+
+// include application headers
+#include "ImageJfif.h"
+#include "QualityEvaluator.h"
+#include "QualitySearchBase.h"
+#include "BufferPool.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerMain( log4cxx::Logger::getLogger( "main" ) );
+#endif //USE_LOG4CXX
+
+ImageShrinker::ImageShrinker( const Settings & settings, ResultCacheShrdPtr cache )
+: m_settings( settings )
+, m_cache( cache )
+{
+    // nothing
+}
+
+long long ImageShrinker::getFileSize( const std::string & path )
+{
+    struct stat fileStat;
+
+    if( stat( path.c_str(), &fileStat ) != 0 )
+    {
+        return -1;
+    }
+
+    return fileStat.st_size;
+}
+
+long long ImageShrinker::estimateMemory( int width, int height, const Settings & settings )
+{
+    int nofCandidates = settings.parallelQualities;
+
+    if( nofCandidates <= 0 )
+    {
+#ifdef _OPENMP
+        nofCandidates = omp_get_max_threads();
+#else
+        nofCandidates = 1;
+#endif //_OPENMP
+    }
+
+    // the 4:4:4 planes are an upper bound for every subsampling; the decoded
+    // input is kept, every candidate needs a converted copy, a compressed
+    // buffer and the decoded candidate
+    const long long frameSize = 3LL * width * height;
+
+    return frameSize * ( 1 + 3 * nofCandidates );
+}
+
+ShrinkResult ImageShrinker::shrink( const std::string & inputFile, const std::string & outputFile ) const
+{
+    // without a record the instrumented stages do not even read the clock
+    if( m_settings.stats != StatsFormat::JSON )
+    {
+        return shrinkImage( inputFile, outputFile );
+    }
+
+    StatsRecord record;
+    ShrinkResult ret;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    {
+        StatsScope scope( &record );
+        ret = shrinkImage( inputFile, outputFile );
+    }
+
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    ret.stats = toJson( inputFile, outputFile, ret, record, seconds.count() );
+
+    return ret;
+}
+
+std::string ImageShrinker::toJson( const std::string & inputFile, const std::string & outputFile,
+                                   const ShrinkResult & result, const StatsRecord & record, double seconds )
+{
+    std::ostringstream os;
+
+    os << "{\"input\":";
+    StatsRecord::writeJsonString( os, inputFile );
+    os << ",\"output\":";
+    StatsRecord::writeJsonString( os, outputFile );
+    os << ",\"success\":" << ( result.success ? "true" : "false" );
+
+    if( !result.success )
+    {
+        os << ",\"error\":";
+        StatsRecord::writeJsonString( os, result.errorMessage );
+    }
+
+    os << ",\"width\":" << result.width
+       << ",\"height\":" << result.height
+       << ",\"quality\":" << result.quality
+       << ",\"encodes\":" << result.nofEvaluations
+       << ",\"inputSize\":" << result.inputSize
+       << ",\"outputSize\":" << result.outputSize
+       << ",\"cached\":" << ( result.fromCache ? "true" : "false" )
+       << ",\"skipped\":" << ( result.skipped ? "true" : "false" )
+       << ",\"ms\":" << std::fixed << std::setprecision( 3 ) << ( seconds * 1.0e3 )
+       << ",";
+
+    record.writeJsonMembers( os );
+
+    os << "}";
+
+    return os.str();
+}
+
+ShrinkResult ImageShrinker::shrinkImage( const std::string & inputFile, const std::string & outputFile ) const
+{
+    ShrinkResult ret;
+    Settings settings = m_settings;
+
+    ret.inputSize = getFileSize( inputFile );
+
+    // a known image is stored with the cached quality or not touched at all
+    uint64_t cacheKey = 0;
+
+    if( m_cache )
+    {
+        long long outputSize = 0;
+
+        cacheKey = ResultCache::calcKey( inputFile, settings, ret.inputSize );
+
+        if(    ( cacheKey != 0 )
+            && ( m_cache->lookup( cacheKey, ret.inputSize, ret.quality, outputSize ) )
+          )
+        {
+            ret.fromCache = true;
+
+            if( getFileSize( outputFile ) == outputSize )
+            {
+                ret.outputSize = outputSize;
+                ret.skipped    = true;
+                ret.success    = true;
+                return ret;
+            }
+        }
+    }
+
+    // the image is decompressed only if it is not shrunk in strips
+    ImageJfif imagejfif1( inputFile, false );
+
+    if( !imagejfif1.isHeaderValid() )
+    {
+        ret.errorMessage = "image file count not be loaded";
+        return ret;
+    }
+
+    ret.width  = imagejfif1.getWidth();
+    ret.height = imagejfif1.getHeight();
+
+    if(    ( settings.memoryLimit > 0 )
+        && ( estimateMemory( imagejfif1.getWidth(), imagejfif1.getHeight(), settings ) > settings.memoryLimit * 1024LL * 1024LL )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_INFO( loggerMain, "memory limit of " << settings.memoryLimit << " MB exceeded; the image is shrunk in strips" );
+#endif //USE_LOG4CXX
+
+        settings.comparisonEngine = ComparisonEngine::STRIPS;
+    }
+
+    const bool inStrips = ( settings.comparisonEngine == ComparisonEngine::STRIPS );
+
+    if(    ( !inStrips )
+        && ( !imagejfif1.decompressImage() )
+      )
+    {
+        ret.errorMessage = "image file count not be loaded";
+        return ret;
+    }
+
+    ChrominanceSubsampling::VALUE cs = imagejfif1.getChrominanceSubsampling();
+    if(    ( cs == ChrominanceSubsampling::CS_444 )
+        && ( settings.cs444to420 )
+       )
+    {
+        cs = ChrominanceSubsampling::CS_420;
+    }
+
+    if( !ret.fromCache )
+    {
+        // a higher quality than the one of the input only increases the file size
+        if( settings.estimateQuality )
+        {
+            const int estimatedQuality = imagejfif1.estimateQuality();
+
+#ifdef USE_LOG4CXX
+            LOG4CXX_INFO( loggerMain, "estimated quality of the input = " << estimatedQuality );
+#endif //USE_LOG4CXX
+
+            if(    ( estimatedQuality > 0 )
+                && ( estimatedQuality < settings.qualityMax )
+              )
+            {
+                settings.qualityMax = std::max( estimatedQuality, settings.qualityMin + 1 );
+            }
+        }
+
+        QualityEvaluator evaluator( imagejfif1, cs, settings.imageCompChunkSize, settings.comparisonEngine, settings.dssimPeakStride, settings.similarityMetric );
+        evaluator.setRejectionLimits( settings.dssimAvgMax, settings.dssimPeakMax );
+        evaluator.setPlaneWeights( settings.dssimWeightY, settings.dssimWeightCb, settings.dssimWeightCr );
+        evaluator.setStatisticsPrecision( settings.statisticsPrecision );
+
+        QualitySearchBaseShrdPtr search = QualitySearchBase::create( settings );
+
+        if( !search )
+        {
+            ret.errorMessage = "quality search could not be created";
+            return ret;
+        }
+
+        ret.quality        = search->findQuality( evaluator );
+        ret.nofEvaluations = evaluator.getNofEvaluations();
+
+        if( evaluator.isEvaluated( ret.quality ) )
+        {
+            ret.compared   = true;
+            ret.comparison = evaluator.evaluate( ret.quality );
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_INFO( loggerMain, "buffer pool: " << BufferPool::getInstance().getNofHits() << " hits, "
+                                                  << BufferPool::getInstance().getNofMisses() << " misses" );
+#endif //USE_LOG4CXX
+    }
+
+    if( settings.copyMarkers )
+    {
+        ImageJfif::ListOfMarkerShrdPtr markers = imagejfif1.getMarkers();
+
+        if( inStrips )
+        {
+            imagejfif1.storeInFileInStrips( outputFile, markers, ret.quality, cs );
+        }
+        else
+        {
+            imagejfif1.storeInFile( outputFile, markers, ret.quality, cs );
+        }
+    }
+    else
+    {
+        if( inStrips )
+        {
+            imagejfif1.storeInFileInStrips( outputFile, ret.quality, cs );
+        }
+        else
+        {
+            imagejfif1.storeInFile( outputFile, ret.quality, cs );
+        }
+    }
+
+    ret.outputSize = getFileSize( outputFile );
+
+    if( ret.outputSize < 0 )
+    {
+        ret.errorMessage = "output file could not be written";
+        return ret;
+    }
+
+    if(    ( m_cache )
+        && ( !ret.fromCache )
+        && ( cacheKey != 0 )
+      )
+    {
+        m_cache->insert( cacheKey, ret.inputSize, ret.quality, ret.outputSize );
+    }
+
+    ret.success = true;
+    return ret;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,109 @@
+
+#ifndef IMAGESHRINKER_H_
+#define IMAGESHRINKER_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <string>
+
+// include application headers
+#include "settings.h"
+#include "ResultCache.h"
+#include "ImageComparisonResult.h"
+#include "StatsRecord.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class ImageShrinker;
+typedef std::shared_ptr<ImageShrinker> ImageShrinkerShrdPtr;
+typedef std::weak_ptr<ImageShrinker>   ImageShrinkerWkPtr;
+
+// outcome of shrinking one image
+struct ShrinkResult
+{
+    ShrinkResult()
+    : success( false )
+    , errorMessage()
+    , quality( 0 )
+    , nofEvaluations( 0 )
+    , width( 0 )
+    , height( 0 )
+    , inputSize( 0 )
+    , outputSize( 0 )
+    , fromCache( false )
+    , skipped( false )
+    , compared( false )
+    , comparison()
+    , stats()
+    {
+        // nothing
+    }
+
+    bool        success;
+    std::string errorMessage;
+    int         quality;
+    int         nofEvaluations;
+    int         width;        // of the input; 0 if not loaded
+    int         height;
+    long long   inputSize;    // in bytes
+    long long   outputSize;   // in bytes
+    bool        fromCache;    // quality taken from the result cache
+    bool        skipped;      // output existed already, nothing written
+
+    bool                  compared;     // comparison of the final quality is known
+    ImageComparisonResult comparison;
+
+    std::string stats;    // JSON record (--stats json); empty otherwise
+};
+
+// declaration
+// loads one image, searches the quality and stores the result
+class ImageShrinker
+: public std::enable_shared_from_this<ImageShrinker>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        ImageShrinker( const Settings & settings, ResultCacheShrdPtr cache = ResultCacheShrdPtr() );
+        virtual ~ImageShrinker() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        Settings           m_settings;
+        ResultCacheShrdPtr m_cache;    // optional
+
+    //********** METHODS **********
+    public:
+        // thread safe; every call works on its own copy of the settings
+        ShrinkResult shrink( const std::string & inputFile, const std::string & outputFile ) const;
+
+        static long long getFileSize( const std::string & path );   // -1 if not available
+
+        // bytes the pixel engine needs for an image (in memory, without strips)
+        static long long estimateMemory( int width, int height, const Settings & settings );
+
+    protected:
+
+    private:
+        ShrinkResult shrinkImage( const std::string & inputFile, const std::string & outputFile ) const;
+
+        static std::string toJson( const std::string & inputFile, const std::string & outputFile,
+                                   const ShrinkResult & result, const StatsRecord & record, double seconds );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //IMAGESHRINKER_H_
@@ -0,0 +1,59 @@
+
+// include system headers
+#include <cstring>      // std::memcpy
+
+// include own headers
+#include "MurmurHash.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+// ...
+
+namespace imageshrink
+{
+
+uint64_t murmurHash64A( const void * data, std::size_t size, uint64_t seed )
+{
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int      r = 47;
+
+    const unsigned char * bytes = static_cast<const unsigned char *>( data );
+    const unsigned char * const end = bytes + ( size / 8 ) * 8;
+
+    uint64_t h = seed ^ ( size * m );
+
+    for( ; bytes != end; bytes += 8 )
+    {
+        uint64_t k;
+        std::memcpy( &k, bytes, 8 );    // unaligned access
+
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        h ^= k;
+        h *= m;
+    }
+
+    switch( size & 7 )
+    {
+        case 7: h ^= uint64_t( bytes[6] ) << 48; // fall through
+        case 6: h ^= uint64_t( bytes[5] ) << 40; // fall through
+        case 5: h ^= uint64_t( bytes[4] ) << 32; // fall through
+        case 4: h ^= uint64_t( bytes[3] ) << 24; // fall through
+        case 3: h ^= uint64_t( bytes[2] ) << 16; // fall through
+        case 2: h ^= uint64_t( bytes[1] ) << 8;  // fall through
+        case 1: h ^= uint64_t( bytes[0] );
+                h *= m;
+    };
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+
+    return h;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,17 @@
+
+#ifndef MURMURHASH_H_
+#define MURMURHASH_H_
+
+// include system headers
+#include <cstddef>
+#include <cstdint>
+
+namespace imageshrink
+{
+
+// MurmurHash64A by Austin Appleby (public domain); fast, not cryptographic
+uint64_t murmurHash64A( const void * data, std::size_t size, uint64_t seed );
+
+} //namespace imageshrink
+
+#endif //MURMURHASH_H_
@@ -0,0 +1,258 @@
+
+// include system headers
+#include <cstring>      // std::memcmp, std::memcpy
+
+#include <fcntl.h>
+#include <sys/file.h>   // flock
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// include own headers
+#include "ResultCache.h"
+
+// include application headers
+#include "MurmurHash.h"
+#include "FileLoader.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerMain( log4cxx::Logger::getLogger( "main" ) );
+#endif //USE_LOG4CXX
+
+static const char cacheMagic[8] = { 'I', 'S', 'C', 'A', 'C', 'H', 'E', '1' };
+
+template<typename T>
+static inline uint64_t hashValue( const T & value, uint64_t seed )
+{
+    return murmurHash64A( &value, sizeof( value ), seed );
+}
+
+ResultCache::ResultCache( const std::string & path )
+: m_fileDescriptor( -1 )
+, m_mapping( nullptr )
+, m_mappingSize( 0 )
+, m_slots( nullptr )
+, m_nofSlots( 0 )
+{
+    if( !open( path ) )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerMain, "result cache " << path << " could not be opened" );
+#endif //USE_LOG4CXX
+        close();
+    }
+}
+
+ResultCache::~ResultCache()
+{
+    close();
+}
+
+bool ResultCache::open( const std::string & path )
+{
+    m_fileDescriptor = ::open( path.c_str(), O_RDWR | O_CREAT, 0644 );
+
+    if( m_fileDescriptor < 0 )
+    {
+        return false;
+    }
+
+    // concurrent processes must not initialize the file twice
+    if( flock( m_fileDescriptor, LOCK_EX ) != 0 )
+    {
+        return false;
+    }
+
+    Header header;
+    struct stat fileStat;
+    bool ok = ( fstat( m_fileDescriptor, &fileStat ) == 0 );
+
+    if( ok && ( fileStat.st_size == 0 ) )
+    {
+        std::memcpy( header.magic, cacheMagic, sizeof( header.magic ) );
+        header.nofSlots = defaultNofSlots;
+
+        // the slots are zero (emptyKey) in the sparse file
+        ok =    ( ftruncate( m_fileDescriptor, sizeof( Header ) + header.nofSlots * sizeof( Slot ) ) == 0 )
+             && ( pwrite( m_fileDescriptor, &header, sizeof( header ), 0 ) == sizeof( header ) );
+
+        fileStat.st_size = sizeof( Header ) + header.nofSlots * sizeof( Slot );
+    }
+    else if( ok )
+    {
+        ok =    ( pread( m_fileDescriptor, &header, sizeof( header ), 0 ) == sizeof( header ) )
+             && ( std::memcmp( header.magic, cacheMagic, sizeof( header.magic ) ) == 0 )
+             && ( header.nofSlots > 0 )
+             && ( static_cast<uint64_t>( fileStat.st_size ) == sizeof( Header ) + header.nofSlots * sizeof( Slot ) );
+    }
+
+    flock( m_fileDescriptor, LOCK_UN );
+
+    if( !ok )
+    {
+        return false;
+    }
+
+    m_mappingSize = fileStat.st_size;
+    m_mapping = mmap( nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0 );
+
+    if( m_mapping == MAP_FAILED )
+    {
+        m_mapping = nullptr;
+        return false;
+    }
+
+    m_nofSlots = header.nofSlots;
+    m_slots    = reinterpret_cast<Slot *>( static_cast<char *>( m_mapping ) + sizeof( Header ) );
+
+    return true;
+}
+
+void ResultCache::close()
+{
+    if( m_mapping != nullptr )
+    {
+        munmap( m_mapping, m_mappingSize );
+    }
+
+    if( m_fileDescriptor >= 0 )
+    {
+        ::close( m_fileDescriptor );
+    }
+
+    m_fileDescriptor = -1;
+    m_mapping        = nullptr;
+    m_mappingSize    = 0;
+    m_slots          = nullptr;
+    m_nofSlots       = 0;
+}
+
+uint64_t ResultCache::calcKey( const std::string & inputFile, const Settings & settings, long long & inputSize )
+{
+    ImageBufferShrdPtr content = loadFile( inputFile );
+
+    if( !content )
+    {
+        return 0;
+    }
+
+    inputSize = content->size;
+
+    // every setting that changes the quality or the output file
+    uint64_t seed = 0;
+    seed = hashValue( settings.qualityMin, seed );
+    seed = hashValue( settings.qualityMax, seed );
+    seed = hashValue( settings.dssimAvgMax, seed );
+    seed = hashValue( settings.dssimPeakMax, seed );
+    seed = hashValue( settings.copyMarkers, seed );
+    seed = hashValue( settings.initQualityStep, seed );
+    seed = hashValue( settings.cs444to420, seed );
+    seed = hashValue( settings.imageCompChunkSize, seed );
+    seed = hashValue( settings.qualitySearch, seed );
+    seed = hashValue( settings.estimateQuality, seed );
+    seed = hashValue( settings.comparisonEngine, seed );
+    seed = hashValue( settings.dssimPeakStride, seed );
+    seed = hashValue( settings.similarityMetric, seed );
+    seed = hashValue( settings.dssimWeightY, seed );
+    seed = hashValue( settings.dssimWeightCb, seed );
+    seed = hashValue( settings.dssimWeightCr, seed );
+    seed = hashValue( settings.statisticsPrecision, seed );
+
+    uint64_t key = murmurHash64A( content->image, content->size, seed );
+
+    // reserved values
+    if( key == emptyKey )
+    {
+        key = 1;
+    }
+    else if( key == busyKey )
+    {
+        key = busyKey - 1;
+    }
+
+    return key;
+}
+
+bool ResultCache::lookup( uint64_t key, long long inputSize, int & quality, long long & outputSize ) const
+{
+    if( !isValid() )
+    {
+        return false;
+    }
+
+    for( int probe = 0; probe < maxProbes; ++probe )
+    {
+        const Slot & slot = m_slots[ ( key + probe ) % m_nofSlots ];
+        const uint64_t slotKey = __atomic_load_n( &slot.key, __ATOMIC_ACQUIRE );
+
+        if( slotKey == emptyKey )
+        {
+            return false;
+        }
+
+        if(    ( slotKey == key )
+            && ( static_cast<long long>( slot.inputSize ) == inputSize )
+          )
+        {
+            quality    = slot.quality;
+            outputSize = slot.outputSize;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ResultCache::insert( uint64_t key, long long inputSize, int quality, long long outputSize )
+{
+    if( !isValid() )
+    {
+        return;
+    }
+
+    for( int probe = 0; probe < maxProbes; )
+    {
+        Slot & slot = m_slots[ ( key + probe ) % m_nofSlots ];
+        uint64_t slotKey = __atomic_load_n( &slot.key, __ATOMIC_ACQUIRE );
+
+        if(    ( slotKey == key )
+            && ( static_cast<long long>( slot.inputSize ) == inputSize )
+          )
+        {
+            return;
+        }
+
+        if( slotKey == emptyKey )
+        {
+            // reserve the slot; on failure it is examined again
+            if( __atomic_compare_exchange_n( &slot.key, &slotKey, busyKey, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+            {
+                slot.inputSize  = inputSize;
+                slot.outputSize = outputSize;
+                slot.quality    = quality;
+                slot.reserved   = 0;
+
+                __atomic_store_n( &slot.key, key, __ATOMIC_RELEASE );
+                return;
+            }
+
+            continue;
+        }
+
+        ++probe;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerMain, "result cache is full around slot " << key % m_nofSlots );
+#endif //USE_LOG4CXX
+}
+
+} //namespace imageshrink
@@ -0,0 +1,99 @@
+
+#ifndef RESULTCACHE_H_
+#define RESULTCACHE_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// include application headers
+#include "settings.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class ResultCache;
+typedef std::shared_ptr<ResultCache> ResultCacheShrdPtr;
+typedef std::weak_ptr<ResultCache>   ResultCacheWkPtr;
+
+// declaration
+// persistent map from (input file content, settings) to the final quality
+// and the output size; the file is a fixed size open addressing hash table
+// that is mapped into memory and shared by concurrent threads and processes
+class ResultCache
+: public std::enable_shared_from_this<ResultCache>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    private:
+        struct Header
+        {
+            char     magic[8];
+            uint64_t nofSlots;
+        };
+
+        // a slot is published by storing its key last; keys are never removed
+        struct Slot
+        {
+            uint64_t key;          // emptyKey, busyKey or the hash
+            uint64_t inputSize;    // guards against hash collisions
+            int64_t  outputSize;
+            int32_t  quality;
+            int32_t  reserved;
+        };
+
+        static const uint64_t emptyKey = 0;
+        static const uint64_t busyKey  = ~0ULL;
+        static const uint64_t defaultNofSlots = 1 << 18;    // 8 MiB
+        static const int      maxProbes = 64;
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        ResultCache( const std::string & path );
+        virtual ~ResultCache();
+
+    protected:
+
+    private:
+        ResultCache( const ResultCache & );               // not copyable
+        ResultCache & operator=( const ResultCache & );   // not copyable
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        int         m_fileDescriptor;
+        void *      m_mapping;
+        std::size_t m_mappingSize;
+        Slot *      m_slots;
+        uint64_t    m_nofSlots;
+
+    //********** METHODS **********
+    public:
+        bool isValid() const { return m_slots != nullptr; }
+
+        // hash of the file content and of all settings that influence the
+        // result; 0 if the file could not be read
+        static uint64_t calcKey( const std::string & inputFile, const Settings & settings, long long & inputSize );
+
+        // thread and process safe
+        bool lookup( uint64_t key, long long inputSize, int & quality, long long & outputSize ) const;
+        void insert( uint64_t key, long long inputSize, int quality, long long outputSize );
+
+    protected:
+
+    private:
+        bool open( const std::string & path );
+        void close();
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //RESULTCACHE_H_
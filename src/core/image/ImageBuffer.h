@@ -4,8 +4,13 @@
 
 // include system headers
 #include <memory> // for smart pointer
+#include <functional>
+#include <new>      // std::bad_alloc
+#include <cstddef>
+#include <cstdlib>  // posix_memalign, free
 
 // include application headers
+#include "StatsRecord.h"
 
 namespace imageshrink
 {
@@ -16,32 +21,83 @@ typedef std::shared_ptr<ImageBuffer> ImageBufferShrdPtr;
 typedef std::weak_ptr<ImageBuffer>   ImageBufferWkPtr;
 
 // declaration
+// own buffers are aligned to (and padded up to a multiple of) 64 bytes,
+// so SIMD kernels may use aligned loads; external memory (mapped files,
+// TurboJPEG or pooled buffers) is wrapped together with its deleter
 struct ImageBuffer
 {
+    // releases external memory; a no-op for memory owned by somebody else
+    typedef std::function<void( unsigned char * image )> Deleter;
+
+    static const std::size_t alignment = 64;   // bytes
+
     ImageBuffer() 
     : image( nullptr )
     , size( 0 ) 
+    , deleter()
     {
         // nothing
     }
 
-    ImageBuffer( int s )
+    ImageBuffer( std::size_t s )
     : image( nullptr )
     , size( 0 )
+    , deleter()
     {
-        image = new unsigned char[s];
+        image = allocate( s );
         size  = s;
     }
 
+    ImageBuffer( unsigned char * i, std::size_t s, const Deleter & d )
+    : image( i )
+    , size( s )
+    , deleter( d )
+    {
+        // nothing
+    }
+
     ~ImageBuffer()
     {
-        delete[] image;
+        if( !deleter )
+        {
+            free( image );
+        }
+        else if( image != nullptr )
+        {
+            deleter( image );
+        }
+
         image = nullptr;
         size = 0;
     }
 
+    static unsigned char * allocate( std::size_t s )
+    {
+        void * ret = nullptr;
+        const std::size_t nofBlocks = ( s + alignment - 1 ) / alignment;
+
+        if( posix_memalign( &ret, alignment, ( ( nofBlocks > 0 ) ? nofBlocks : 1 ) * alignment ) != 0 )
+        {
+            throw std::bad_alloc();
+        }
+
+        StatsRecord * const record = StatsRecord::getCurrent();
+
+        if( record != nullptr )
+        {
+            record->addAllocation( ( ( nofBlocks > 0 ) ? nofBlocks : 1 ) * alignment );
+        }
+
+        return static_cast<unsigned char *>( ret );
+    }
+
     unsigned char * image;
-    int             size;
+    std::size_t     size;
+    Deleter         deleter;
+
+private:
+    ImageBuffer( const ImageBuffer & );               // not copyable
+    ImageBuffer & operator=( const ImageBuffer & );   // not copyable
 };
 
 } //namespace imageshrink
@@ -1,7 +1,6 @@
 
 // include system headers
 #include <fstream>      // std::ifstream
-#include <limits>       // std::numeric_limits<...>::...
 #include <cstring>      // std::memcpy
 
 // include own headers
@@ -9,6 +8,12 @@
 
 // include application headers
 #include "PlanarImageCalc.h"
+#include "ChromaResampling.h"
+#include "TurboJpegContext.h"
+#include "FileLoader.h"
+#include "BufferPool.h"
+#include "PlaneBands.h"
+#include "ScopedTimer.h"
 
 // include 3rd party headers
 #include <turbojpeg.h>
@@ -32,7 +37,9 @@ ImageJfif::ImageJfif()
 , m_imageBuffer()
 , m_width( 0 )
 , m_height( 0 )
+, m_compressedImageBuffer()
 , m_listOfMarkers()
+, m_listOfQuantizationTables()
 {
     reset();
 }
@@ -44,6 +51,28 @@ ImageJfif::ImageJfif( stringConstShrdPtr path )
 }
 
 ImageJfif::ImageJfif( const std::string & path )
+: ImageJfif( path, true )
+{
+    // nothing
+}
+
+ImageJfif::ImageJfif( const std::string & path, bool decompressNow )
+: m_pixelFormat( PixelFormat::UNKNOWN )
+, m_colorspace( Colorspace::UNKNOWN  )
+, m_bitsPerPixelAndChannel( BitsPerPixelAndChannel::UNKNOWN )
+, m_chrominanceSubsampling( ChrominanceSubsampling::UNKNOWN )
+, m_imageBuffer()
+, m_width( 0 )
+, m_height( 0 )
+, m_compressedImageBuffer()
+, m_listOfMarkers()
+, m_listOfQuantizationTables()
+{
+    reset();
+    loadImage( path, decompressNow );
+}
+
+ImageJfif::ImageJfif( ImageBufferShrdPtr compressedImage, bool decompressNow )
 : m_pixelFormat( PixelFormat::UNKNOWN )
 , m_colorspace( Colorspace::UNKNOWN  )
 , m_bitsPerPixelAndChannel( BitsPerPixelAndChannel::UNKNOWN )
@@ -51,10 +80,21 @@ ImageJfif::ImageJfif( const std::string & path )
 , m_imageBuffer()
 , m_width( 0 )
 , m_height( 0 )
+, m_compressedImageBuffer()
 , m_listOfMarkers()
+, m_listOfQuantizationTables()
 {
     reset();
-    loadImage( path );
+
+    if( !compressedImage )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "compressedImage is a nullptr" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+    setCompressedImage( compressedImage, decompressNow );
 }
 
 ImageJfif::ImageJfif( const ImageInterface & image )
@@ -65,7 +105,9 @@ ImageJfif::ImageJfif( const ImageInterface & image )
 , m_imageBuffer()
 , m_width( 0 )
 , m_height( 0 )
+, m_compressedImageBuffer()
 , m_listOfMarkers()
+, m_listOfQuantizationTables()
 {
     m_pixelFormat            = image.getPixelFormat();
     m_colorspace             = image.getColorspace();
@@ -91,39 +133,42 @@ void ImageJfif::reset()
     m_imageBuffer.reset();
 }
 
-void ImageJfif::loadImage( const std::string & path )
+void ImageJfif::loadImage( const std::string & path, bool decompressNow )
 {
-    // int tjRet = 0;
-
-    // open file
-    std::ifstream ifs( path.c_str(), std::ifstream::in | std::ifstream::binary );
-
-    // determine size of file
-    ifs.ignore( std::numeric_limits<std::streamsize>::max() );
-    const std::streamsize length = ifs.gcount();
-    ifs.clear();   //  Since ignore will have set eof.
-    ifs.seekg( 0, std::ios_base::beg );
+    // map (or read) file; the bytes are used in place
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerImage, "read JFIF file ..." );
+#endif //USE_LOG4CXX
 
-    const long unsigned int jpegSize = length;
+    ScopedTimer loadTimer( Stage::LOAD_IMAGE );
+    ImageBufferShrdPtr compressedImage = loadFile( path );
 
-    // read file
+    if( !compressedImage )
+    {
 #ifdef USE_LOG4CXX
-    LOG4CXX_INFO( loggerImage, "read JFIF file with " << length << " Bytes ..." );
+        LOG4CXX_ERROR( loggerImage, "JFIF file " << path << " could not be read" );
 #endif //USE_LOG4CXX
-
-    ImageBufferShrdPtr compressedImage = std::make_shared<ImageBuffer>(jpegSize);
-    ifs.read( reinterpret_cast<char*>( compressedImage->image ), length );
-    ifs.close();
+        reset();
+        return;
+    }
 
 #ifdef USE_LOG4CXX
-    LOG4CXX_INFO( loggerImage, "read JFIF file with " << length << " Bytes ... done" );
+    LOG4CXX_INFO( loggerImage, "read JFIF file with " << compressedImage->size << " Bytes ... done" );
 #endif //USE_LOG4CXX
-    
-    // decompress jpeg
-    ImageJfif image = decompress( compressedImage );
+
+    setCompressedImage( compressedImage, decompressNow );
+}
+
+void ImageJfif::setCompressedImage( ImageBufferShrdPtr compressedImage, bool decompressNow )
+{
+    // decompress jpeg (or read the header only; the image is decompressed later or in strips)
+    ImageJfif image = decompressNow ? decompress( compressedImage ) : decompressHeader( compressedImage );
 
     // parse input file and copy markers
-    m_listOfMarkers = copyMarkers( compressedImage );
+    m_listOfMarkers = copyMarkers( compressedImage, m_listOfQuantizationTables );
+
+    // keep the compressed image for engines working on the DCT coefficients
+    m_compressedImageBuffer = compressedImage;
 
     // copy data
     m_pixelFormat            = image.m_pixelFormat;
@@ -135,6 +180,20 @@ void ImageJfif::loadImage( const std::string & path )
     m_height                 = image.m_height;
 }
 
+bool ImageJfif::decompressImage()
+{
+    if( m_imageBuffer )
+    {
+        return true;
+    }
+
+    ImageJfif image = decompress( m_compressedImageBuffer );
+
+    m_imageBuffer = image.m_imageBuffer;
+
+    return static_cast<bool>( m_imageBuffer );
+}
+
 void ImageJfif::storeInFile( const std::string & path, int quality, ChrominanceSubsampling::VALUE cs )
 {    
     if( !m_imageBuffer )
@@ -149,17 +208,7 @@ void ImageJfif::storeInFile( const std::string & path, int quality, ChrominanceS
     ImageBufferShrdPtr compressedImage = compress( *this, quality, cs );
 
     // write new image
-#ifdef USE_LOG4CXX
-    LOG4CXX_INFO( loggerImage, "write to file ..." );
-#endif //USE_LOG4CXX
-
-    std::ofstream ofs ( path.c_str(), std::ifstream::out | std::ifstream::binary );
-    ofs.write( reinterpret_cast<const char*>( compressedImage->image ), compressedImage->size );
-    ofs.close();
-
-#ifdef USE_LOG4CXX
-    LOG4CXX_INFO( loggerImage, "write to file ... done" );
-#endif //USE_LOG4CXX
+    writeFile( path, compressedImage );
 }
 
 void ImageJfif::storeInFile( const std::string & path, const ListOfMarkerShrdPtr & markers, int quality, ChrominanceSubsampling::VALUE cs )
@@ -179,6 +228,19 @@ void ImageJfif::storeInFile( const std::string & path, const ListOfMarkerShrdPtr
     compressedImage = enrichCompressedImageWithMakers( compressedImage, markers );
 
     // write new image
+    writeFile( path, compressedImage );
+}
+
+void ImageJfif::writeFile( const std::string & path, ImageBufferShrdPtr compressedImage )
+{
+    if( !compressedImage )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "compressedImage is a nullptr" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerImage, "write to file ..." );
 #endif //USE_LOG4CXX
@@ -192,7 +254,7 @@ void ImageJfif::storeInFile( const std::string & path, const ListOfMarkerShrdPtr
 #endif //USE_LOG4CXX
 }
 
-ImageJfif ImageJfif::decompress( ImageBufferShrdPtr compressedImage )
+ImageJfif ImageJfif::decompressHeader( ImageBufferShrdPtr compressedImage )
 {
     ImageJfif ret;
     int tjRet = 0;
@@ -206,8 +268,13 @@ ImageJfif ImageJfif::decompress( ImageBufferShrdPtr compressedImage )
         return ret;
     }
 
-    // decompress jpeg
-    tjhandle jpegDecompressor = tjInitDecompress();
+    // read the header
+    tjhandle jpegDecompressor = TurboJpegContext::getThreadContext().getDecompressor();
+
+    if( jpegDecompressor == nullptr )
+    {
+        return ret;
+    }
 
     int jpegSubsamp, width, height, jpegColorspace;
     tjRet = tjDecompressHeader3(
@@ -242,29 +309,52 @@ ImageJfif ImageJfif::decompress( ImageBufferShrdPtr compressedImage )
 #ifdef USE_LOG4CXX
         LOG4CXX_ERROR( loggerImage, "tjGetErrorStr(): " <<  tjGetErrorStr() );
 #endif //USE_LOG4CXX
+    }
+
+    return ret;
+}
+
+ImageJfif ImageJfif::decompress( ImageBufferShrdPtr compressedImage )
+{
+    ImageJfif ret = decompressHeader( compressedImage );
+    int tjRet = 0;
+
+    if( ret.m_chrominanceSubsampling == ChrominanceSubsampling::UNKNOWN )
+    {
         return ret;
     }
 
+    // decompress jpeg
+    tjhandle jpegDecompressor = TurboJpegContext::getThreadContext().getDecompressor();
+
+    const int width       = ret.m_width;
+    const int height      = ret.m_height;
+    const int jpegSubsamp = convert2Tj( ret.m_chrominanceSubsampling );
+
     // allocate buffer for decompressed image
     const unsigned long yuvPlanarBufferSize = tjBufSizeYUV2( width, /*pad*/ TJ_PAD, height, jpegSubsamp );
-    ImageBufferShrdPtr imageBuffer = std::make_shared<ImageBuffer>( yuvPlanarBufferSize );
+    ImageBufferShrdPtr imageBuffer = BufferPool::getInstance().getBuffer( yuvPlanarBufferSize );
 
     // decompress image
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerImage, "decompress JFIF image ..." );
 #endif //USE_LOG4CXX
 
-    tjRet = tjDecompressToYUV2(
-        jpegDecompressor, 
-        reinterpret_cast<const unsigned char*>( compressedImage->image ), 
-        compressedImage->size, 
-        imageBuffer->image,
-        width, 
-        /*pad*/ TJ_PAD,
-        height, 
-        // tjOutputPixelFormat, 
-        TJFLAG_ACCURATEDCT /*TJFLAG_FASTDCT*/
-    );
+    {
+        ScopedTimer timer( Stage::DECOMPRESS );
+
+        tjRet = tjDecompressToYUV2(
+            jpegDecompressor, 
+            reinterpret_cast<const unsigned char*>( compressedImage->image ), 
+            compressedImage->size, 
+            imageBuffer->image,
+            width, 
+            /*pad*/ TJ_PAD,
+            height, 
+            // tjOutputPixelFormat, 
+            TJFLAG_ACCURATEDCT /*TJFLAG_FASTDCT*/
+        );
+    }
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerImage, "decompress JFIF image ... done" );
@@ -282,8 +372,6 @@ ImageJfif ImageJfif::decompress( ImageBufferShrdPtr compressedImage )
 #endif //USE_LOG4CXX
     }
 
-    tjDestroy(jpegDecompressor);
-
     return ret;
 }
 
@@ -315,28 +403,39 @@ ImageBufferShrdPtr ImageJfif::compress( const ImageJfif & notCompressed, int qua
 
 
 
-    // compress jpeg
-    tjhandle jpegCompressor = tjInitCompress();
+    // compress jpeg; handle and destination buffer are reused by the thread
+    TurboJpegContext & context = TurboJpegContext::getThreadContext();
+    tjhandle jpegCompressor = context.getCompressor();
+
+    if( jpegCompressor == nullptr )
+    {
+        return ret;
+    }
 
     long unsigned int jpegSize = tjBufSize( image4Compression.m_width, image4Compression.m_height, jpegSubsamp );
-    unsigned char* compressedImageBuffer = tjAlloc( jpegSize );
+    ImageBufferShrdPtr destination = context.getDestinationBuffer( jpegSize );
+    unsigned char* compressedImageBuffer = destination->image;
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerImage, "compress image ..." );
 #endif //USE_LOG4CXX
 
-    tjRet = tjCompressFromYUV(
-        jpegCompressor,
-        reinterpret_cast<const unsigned char*>( image4Compression.m_imageBuffer->image ),
-        image4Compression.m_width,
-        /*pad*/ TJ_PAD,
-        image4Compression.m_height,
-        jpegSubsamp,
-        &compressedImageBuffer,
-        &jpegSize,
-        quality,
-        TJFLAG_ACCURATEDCT /*TJFLAG_FASTDCT*/
-    );
+    {
+        ScopedTimer timer( Stage::COMPRESS );
+
+        tjRet = tjCompressFromYUV(
+            jpegCompressor,
+            reinterpret_cast<const unsigned char*>( image4Compression.m_imageBuffer->image ),
+            image4Compression.m_width,
+            /*pad*/ TJ_PAD,
+            image4Compression.m_height,
+            jpegSubsamp,
+            &compressedImageBuffer,
+            &jpegSize,
+            quality,
+            TJFLAG_ACCURATEDCT /*TJFLAG_FASTDCT*/ | TJFLAG_NOREALLOC
+        );
+    }
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerImage, "compress image ... done" );
@@ -344,8 +443,9 @@ ImageBufferShrdPtr ImageJfif::compress( const ImageJfif & notCompressed, int qua
 
     if( tjRet == 0 )
     {
-        ret = std::make_shared<ImageBuffer>(jpegSize);
-        std::memcpy( ret->image, compressedImageBuffer, jpegSize );
+        // the destination buffer is handed over without a copy
+        destination->size = jpegSize;
+        ret = destination;
     }
     else
     {
@@ -355,9 +455,6 @@ ImageBufferShrdPtr ImageJfif::compress( const ImageJfif & notCompressed, int qua
 #endif //USE_LOG4CXX
     }
 
-    tjFree( compressedImageBuffer );
-    tjDestroy( jpegCompressor );
-
     return ret;
 }
 
@@ -416,6 +513,7 @@ ImageJfif ImageJfif::convertChrominanceSubsampling( const ImageJfif & image, Chr
 
 ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & image )
 {
+    ScopedTimer timer( Stage::CHROMA_444TO420 );
     ImageJfif ret;
 
     // check image
@@ -437,7 +535,7 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & i
     const int planaImageNewHeight1MainPart = ( planaImageOld.height1 / 2 );
     const int planaImageNewWidth1MainPart  = ( planaImageOld.width1 / 2 );
 
-    ImageBufferShrdPtr imageBufferNew = std::make_shared<ImageBuffer>( planaImageNew.bufferSize );
+    ImageBufferShrdPtr imageBufferNew = BufferPool::getInstance().getBuffer( planaImageNew.bufferSize );
     ImageBufferShrdPtr imageBufferOld = image.getImageBuffer();
 
     // if( ( planaImageNew.planeSize0 + planaImageNew.planeSize1 + planaImageNew.planeSize2 ) != planaImageNew.bufferSize )
@@ -467,58 +565,53 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & i
     const unsigned char * const plane1Old = &imageBufferOld->image[ planaImageOld.planeSize0 ];
     const unsigned char * const plane2Old = &imageBufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ];
 
-    #pragma omp parallel sections
+    const ChromaResamplingImplementation & resampling = getChromaResampling();
+
+    unsigned char * const planesNew[3]       = { plane0New, plane1New, plane2New };
+    const unsigned char * const planesOld[3] = { plane0Old, plane1Old, plane2Old };
+    const int stridesNew[3] = { planaImageNew.stride0, planaImageNew.stride1, planaImageNew.stride2 };
+    const int stridesOld[3] = { planaImageOld.stride0, planaImageOld.stride1, planaImageOld.stride2 };
+
+    // a chroma line pair is read and one line is written; a luminance line is copied
+    const int costPerLine[3] = { planaImageNew.stride0, 3 * planaImageNewWidth1MainPart, 3 * planaImageNewWidth1MainPart };
+    const int nofLines[3]    = { planaImageNew.height0, planaImageNewHeight1MainPart, planaImageNewHeight1MainPart };
+
+    // main parts (vectorized line by line); the lines of all planes are distributed over the threads together
+    runPlaneBands( calcPlaneBands( costPerLine, nofLines, 3 ), [&]( int plane, int yBegin, int yEnd )
     {
-        // copy chroma
-        #pragma omp section
+        // copy luminance
+        if( plane == 0 )
+        {
+            std::memcpy( &plane0New[ stridesNew[0] * yBegin ], &plane0Old[ stridesNew[0] * yBegin ], stridesNew[0] * ( yEnd - yBegin ) );
+            return;
+        }
+
+        for( int y = yBegin; y < yEnd; ++y )
         {
-            std::memcpy( plane0New, plane0Old, planaImageNew.planeSize0 );
+            const int yOld = y * 2;
+
+            resampling.downsample2x2( &planesOld[ plane ][ stridesOld[ plane ] * ( yOld + 0 ) ],
+                                      &planesOld[ plane ][ stridesOld[ plane ] * ( yOld + 1 ) ],
+                                      &planesNew[ plane ][ stridesNew[ plane ] * y ],
+                                      planaImageNewWidth1MainPart );
         }
+    } );
 
+    // remaining parts of the chroma planes at the right side and at the bottom
+    {
         // create U/Cb Plane
-        #pragma omp section
         {
             const int bytesPerPixel = 1;
             const int bytesPerNewLine = planaImageNew.stride1;
             const int bytesPerOldLine = planaImageOld.stride1;
 
-            // main part
-            for( int y = 0; y < planaImageNewHeight1MainPart; ++y )
-            {
-                const int yOld = y * 2;
-
-                for( int x = 0; x < planaImageNewWidth1MainPart; ++x )
-                {
-                    const int xOld = x * 2;
-
-                    const int xOldByteOffset_0_0 = bytesPerPixel *   ( xOld + 0 );
-                    const int yOldByteOffset_0_0 = bytesPerOldLine * ( yOld + 0 );
-                    const int xOldByteOffset_0_1 = bytesPerPixel *   ( xOld + 0 );
-                    const int yOldByteOffset_0_1 = bytesPerOldLine * ( yOld + 1 );
-                    const int xOldByteOffset_1_0 = bytesPerPixel *   ( xOld + 1 );
-                    const int yOldByteOffset_1_0 = bytesPerOldLine * ( yOld + 0 );
-                    const int xOldByteOffset_1_1 = bytesPerPixel *   ( xOld + 1 );
-                    const int yOldByteOffset_1_1 = bytesPerOldLine * ( yOld + 1 );
-
-                    int sum = 0;
-                    sum += plane1Old[ xOldByteOffset_0_0 + yOldByteOffset_0_0 ];
-                    sum += plane1Old[ xOldByteOffset_1_0 + yOldByteOffset_1_0 ];
-                    sum += plane1Old[ xOldByteOffset_0_1 + yOldByteOffset_0_1 ];
-                    sum += plane1Old[ xOldByteOffset_1_1 + yOldByteOffset_1_1 ];
-
-                    const int xNewByteOffset = bytesPerPixel * x;
-                    const int yNewByteOffset = bytesPerNewLine * y;
-
-                    plane1New[ xNewByteOffset + yNewByteOffset ] = sum / 4;
-                }
-            }
-
             // remaining part at the right side
             if( ( planaImageNew.width1 * 2 ) > planaImageOld.width1 )
             {
                 const int xOld = ( planaImageOld.width1 - 1 );
 
-                for( int y = 0; y < planaImageNew.height1; ++y )
+                // an incomplete line pair is handled with the bottom right pixel
+                for( int y = 0; y < planaImageNewHeight1MainPart; ++y )
                 {
                     const int yOld = y * 2;
 
@@ -543,7 +636,8 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & i
             {
                 const int yOld = ( planaImageOld.height1 - 1 );
 
-                for( int x = 0; x < planaImageNew.width1; ++x )
+                // an incomplete column pair is handled with the bottom right pixel
+                for( int x = 0; x < planaImageNewWidth1MainPart; ++x )
                 {
                     const int xOld = x * 2;
 
@@ -585,49 +679,18 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & i
         }
 
         // create V/Cr Plane
-        #pragma omp section
         {
             const int bytesPerPixel = 1;
             const int bytesPerNewLine = planaImageNew.stride2;
             const int bytesPerOldLine = planaImageOld.stride2;
 
-            // main part
-            for( int y = 0; y < planaImageNewHeight1MainPart; ++y )
-            {
-                const int yOld = y * 2;
-
-                for( int x = 0; x < planaImageNewWidth1MainPart; ++x )
-                {
-                    const int xOld = x * 2;
-
-                    const int xOldByteOffset_0_0 = bytesPerPixel *   ( xOld + 0 );
-                    const int yOldByteOffset_0_0 = bytesPerOldLine * ( yOld + 0 );
-                    const int xOldByteOffset_0_1 = bytesPerPixel *   ( xOld + 0 );
-                    const int yOldByteOffset_0_1 = bytesPerOldLine * ( yOld + 1 );
-                    const int xOldByteOffset_1_0 = bytesPerPixel *   ( xOld + 1 );
-                    const int yOldByteOffset_1_0 = bytesPerOldLine * ( yOld + 0 );
-                    const int xOldByteOffset_1_1 = bytesPerPixel *   ( xOld + 1 );
-                    const int yOldByteOffset_1_1 = bytesPerOldLine * ( yOld + 1 );
-
-                    int sum = 0;
-                    sum += plane2Old[ xOldByteOffset_0_0 + yOldByteOffset_0_0 ];
-                    sum += plane2Old[ xOldByteOffset_1_0 + yOldByteOffset_1_0 ];
-                    sum += plane2Old[ xOldByteOffset_0_1 + yOldByteOffset_0_1 ];
-                    sum += plane2Old[ xOldByteOffset_1_1 + yOldByteOffset_1_1 ];
-
-                    const int xNewByteOffset = bytesPerPixel * x;
-                    const int yNewByteOffset = bytesPerNewLine * y;
-
-                    plane2New[ xNewByteOffset + yNewByteOffset ] = sum / 4;
-                }
-            }
-
             // remaining part at the right side
             if( ( planaImageNew.width2 * 2 ) > planaImageOld.width2 )
             {
                 const int xOld = ( planaImageOld.width2 - 1 );
 
-                for( int y = 0; y < planaImageNew.height2; ++y )
+                // an incomplete line pair is handled with the bottom right pixel
+                for( int y = 0; y < planaImageNewHeight1MainPart; ++y )
                 {
                     const int yOld = y * 2;
 
@@ -640,7 +703,7 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & i
                     sum += plane2Old[ xOldByteOffset_0_0 + yOldByteOffset_0_0 ];
                     sum += plane2Old[ xOldByteOffset_0_1 + yOldByteOffset_0_1 ];
                     
-                    const int xNewByteOffset = bytesPerPixel * ( planaImageNew.width1 - 1 );
+                    const int xNewByteOffset = bytesPerPixel * ( planaImageNew.width2 - 1 );
                     const int yNewByteOffset = bytesPerNewLine * y;
 
                     plane2New[ xNewByteOffset + yNewByteOffset ] = sum / 2;
@@ -652,7 +715,8 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & i
             {
                 const int yOld = ( planaImageOld.height2 - 1 );
 
-                for( int x = 0; x < planaImageNew.width2; ++x )
+                // an incomplete column pair is handled with the bottom right pixel
+                for( int x = 0; x < planaImageNewWidth1MainPart; ++x )
                 {
                     const int xOld = x * 2;
 
@@ -708,6 +772,7 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_444to420( const ImageJfif & i
 
 ImageJfif ImageJfif::convertChrominanceSubsampling_420to444( const ImageJfif & image )
 {
+    ScopedTimer timer( Stage::CHROMA_420TO444 );
     ImageJfif ret;
 
     // check image
@@ -726,7 +791,7 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_420to444( const ImageJfif & i
     PlanarImageDesc planaImageNew = calcPlanaerImageDescForYUV( width, height, ChrominanceSubsampling::CS_444, TJ_PAD );
     PlanarImageDesc planaImageOld = calcPlanaerImageDescForYUV( width, height, ChrominanceSubsampling::CS_420, TJ_PAD );
 
-    ImageBufferShrdPtr imageBufferNew = std::make_shared<ImageBuffer>( planaImageNew.bufferSize );
+    ImageBufferShrdPtr imageBufferNew = BufferPool::getInstance().getBuffer( planaImageNew.bufferSize );
     ImageBufferShrdPtr imageBufferOld = image.getImageBuffer();
 
     // if( ( planaImageNew.planeSize0 + planaImageNew.planeSize1 + planaImageNew.planeSize2 ) != planaImageNew.bufferSize )
@@ -756,47 +821,48 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_420to444( const ImageJfif & i
     const unsigned char * const plane1Old = &imageBufferOld->image[ planaImageOld.planeSize0 ];
     const unsigned char * const plane2Old = &imageBufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ];
 
-    #pragma omp parallel sections
+    const ChromaResamplingImplementation & resampling = getChromaResampling();
+
+    unsigned char * const planesNew[3]       = { plane0New, plane1New, plane2New };
+    const unsigned char * const planesOld[3] = { plane0Old, plane1Old, plane2Old };
+    const int stridesNew[3] = { planaImageNew.stride0, planaImageNew.stride1, planaImageNew.stride2 };
+    const int stridesOld[3] = { planaImageOld.stride0, planaImageOld.stride1, planaImageOld.stride2 };
+    const int widthsNew[3]  = { planaImageNew.width0, planaImageNew.width1, planaImageNew.width2 };
+
+    // a chroma line is read and a line pair is written; a luminance line is copied
+    const int costPerLine[3] = { planaImageNew.stride0, 3 * planaImageNew.width1, 3 * planaImageNew.width2 };
+    const int nofLines[3]    = { planaImageNew.height0, planaImageNew.height1 / 2, planaImageNew.height2 / 2 };
+
+    // main parts (vectorized line by line; the second line is a copy of the first one);
+    // the lines of all planes are distributed over the threads together
+    runPlaneBands( calcPlaneBands( costPerLine, nofLines, 3 ), [&]( int plane, int yBegin, int yEnd )
     {
-        // copy chroma
-        #pragma omp section
+        const int bytesPerPixel = 1;
+
+        // copy luminance
+        if( plane == 0 )
         {
-            std::memcpy( plane0New, plane0Old, planaImageNew.planeSize0 );
+            std::memcpy( &plane0New[ stridesNew[0] * yBegin ], &plane0Old[ stridesNew[0] * yBegin ], stridesNew[0] * ( yEnd - yBegin ) );
+            return;
         }
 
+        for( int y = yBegin; y < yEnd; ++y )
+        {
+            unsigned char * const lineNew = &planesNew[ plane ][ stridesNew[ plane ] * ( y * 2 + 0 ) ];
+
+            resampling.upsample2x( &planesOld[ plane ][ stridesOld[ plane ] * y ], lineNew, widthsNew[ plane ] / 2 );
+            std::memcpy( lineNew + stridesNew[ plane ], lineNew, bytesPerPixel * ( widthsNew[ plane ] / 2 ) * 2 );
+        }
+    } );
+
+    // remaining parts of the chroma planes at the right side and at the bottom
+    {
         // create U/Cb Plane
-        #pragma omp section
         {
             const int bytesPerPixel = 1;
             const int bytesPerNewLine = planaImageNew.stride1;
             const int bytesPerOldLine = planaImageOld.stride1;
 
-            // main part
-            for( int y = 0; y < ( planaImageNew.height1 / 2 ); ++y )
-            {
-                for( int x = 0; x < ( planaImageNew.width1 / 2 ); ++x )
-                {
-                    const int xOldByteOffset = bytesPerPixel * x;
-                    const int yOldByteOffset = bytesPerOldLine * y;
-
-                    const unsigned char value = plane1Old[ xOldByteOffset + yOldByteOffset ];
-
-                    const int xNewByteOffset_0_0 = bytesPerPixel   * ( x * 2 + 0 );
-                    const int yNewByteOffset_0_0 = bytesPerNewLine * ( y * 2 + 0 );
-                    const int xNewByteOffset_0_1 = bytesPerPixel   * ( x * 2 + 0 );
-                    const int yNewByteOffset_0_1 = bytesPerNewLine * ( y * 2 + 1 );
-                    const int xNewByteOffset_1_0 = bytesPerPixel   * ( x * 2 + 1 );
-                    const int yNewByteOffset_1_0 = bytesPerNewLine * ( y * 2 + 0 );
-                    const int xNewByteOffset_1_1 = bytesPerPixel   * ( x * 2 + 1 );
-                    const int yNewByteOffset_1_1 = bytesPerNewLine * ( y * 2 + 1 );
-
-                    plane1New[ xNewByteOffset_0_0 + yNewByteOffset_0_0 ] = value;
-                    plane1New[ xNewByteOffset_1_0 + yNewByteOffset_1_0 ] = value;
-                    plane1New[ xNewByteOffset_0_1 + yNewByteOffset_0_1 ] = value;
-                    plane1New[ xNewByteOffset_1_1 + yNewByteOffset_1_1 ] = value;
-                }
-            }
-
             // remaining part at the right side
             if( ( planaImageNew.width1 / 2 ) < planaImageOld.width1 )
             {
@@ -862,38 +928,11 @@ ImageJfif ImageJfif::convertChrominanceSubsampling_420to444( const ImageJfif & i
         }
 
         // create V/Cr Plane
-        #pragma omp section
         {
             const int bytesPerPixel = 1;
             const int bytesPerNewLine = planaImageNew.stride2;
             const int bytesPerOldLine = planaImageOld.stride2;
 
-            // main part
-            for( int y = 0; y < ( planaImageNew.height2 / 2 ); ++y )
-            {
-                for( int x = 0; x < ( planaImageNew.width2 / 2 ); ++x )
-                {
-                    const int xOldByteOffset = bytesPerPixel * x;
-                    const int yOldByteOffset = bytesPerOldLine * y;
-
-                    const unsigned char value = plane2Old[ xOldByteOffset + yOldByteOffset ];
-
-                    const int xNewByteOffset_0_0 = bytesPerPixel   * ( x * 2 + 0 );
-                    const int yNewByteOffset_0_0 = bytesPerNewLine * ( y * 2 + 0 );
-                    const int xNewByteOffset_0_1 = bytesPerPixel   * ( x * 2 + 0 );
-                    const int yNewByteOffset_0_1 = bytesPerNewLine * ( y * 2 + 1 );
-                    const int xNewByteOffset_1_0 = bytesPerPixel   * ( x * 2 + 1 );
-                    const int yNewByteOffset_1_0 = bytesPerNewLine * ( y * 2 + 0 );
-                    const int xNewByteOffset_1_1 = bytesPerPixel   * ( x * 2 + 1 );
-                    const int yNewByteOffset_1_1 = bytesPerNewLine * ( y * 2 + 1 );
-
-                    plane2New[ xNewByteOffset_0_0 + yNewByteOffset_0_0 ] = value;
-                    plane2New[ xNewByteOffset_1_0 + yNewByteOffset_1_0 ] = value;
-                    plane2New[ xNewByteOffset_0_1 + yNewByteOffset_0_1 ] = value;
-                    plane2New[ xNewByteOffset_1_1 + yNewByteOffset_1_1 ] = value;
-                }
-            }
-
             // remaining part at the right side
             if( ( planaImageNew.width2 / 2 ) < planaImageOld.width2 )
             {
@@ -976,13 +1015,27 @@ ImageJfif ImageJfif::getImageWithChrominanceSubsampling( ChrominanceSubsampling:
     return convertChrominanceSubsampling( *this, cs );
 }
 
+ImageBufferShrdPtr ImageJfif::getCompressedImage( int quality, ChrominanceSubsampling::VALUE cs )
+{
+    return compress( *this, quality, cs );
+}
+
 ImageJfif ImageJfif::getCompressedDecompressedImage( int quality, ChrominanceSubsampling::VALUE cs )
+{
+    long long compressedSize = 0;
+
+    return getCompressedDecompressedImage( quality, cs, compressedSize );
+}
+
+ImageJfif ImageJfif::getCompressedDecompressedImage( int quality, ChrominanceSubsampling::VALUE cs, long long & compressedSize )
 {
     ImageBufferShrdPtr compressedImage   = compress( *this, quality, cs );
     ImageJfif          decompressedImage = decompress( compressedImage );
+
+    compressedSize = compressedImage ? compressedImage->size : 0;
     
 #ifdef USE_LOG4CXX
-    LOG4CXX_INFO( loggerImage, "The size of the compressed image is " << compressedImage->size << " Bytes (quality " << quality << ")." );
+    LOG4CXX_INFO( loggerImage, "The size of the compressed image is " << compressedSize << " Bytes (quality " << quality << ")." );
 #endif //USE_LOG4CXX
     
     return decompressedImage;
@@ -35,12 +35,23 @@ class ImageJfif
         typedef std::weak_ptr<Marker>    MarkerWkPtr;
         typedef std::list<MarkerShrdPtr> ListOfMarkerShrdPtr;
 
+        struct QuantizationTable
+        {
+            int            id;
+            unsigned short values[64];  // natural (row-major) order
+        };
+
+        typedef std::shared_ptr<QuantizationTable>  QuantizationTableShrdPtr;
+        typedef std::weak_ptr<QuantizationTable>    QuantizationTableWkPtr;
+        typedef std::list<QuantizationTableShrdPtr> ListOfQuantizationTableShrdPtr;
 
     //********** (DE/CON)STRUCTORS **********
     public:
         ImageJfif();
         ImageJfif( stringConstShrdPtr path );
         ImageJfif( const std::string & path );
+        ImageJfif( const std::string & path, bool decompressNow );   // false: header, markers and compressed data only
+        ImageJfif( ImageBufferShrdPtr compressedImage, bool decompressNow = true );   // JFIF image in memory
         ImageJfif( const ImageInterface & image );
         ImageJfif( ImageInterfaceShrdPtr image );
         virtual ~ImageJfif() {}
@@ -64,7 +75,9 @@ class ImageJfif
         int                           m_width;
         int                           m_height;
 
+        ImageBufferShrdPtr            m_compressedImageBuffer;
         ListOfMarkerShrdPtr           m_listOfMarkers;
+        ListOfQuantizationTableShrdPtr m_listOfQuantizationTables;
 
     //********** METHODS **********
     public:
@@ -80,21 +93,46 @@ class ImageJfif
         virtual void reset();
 
         // own functions
+        ImageBufferShrdPtr getCompressedImage( int quality, ChrominanceSubsampling::VALUE cs = ChrominanceSubsampling::CS_444 );
         ImageJfif getCompressedDecompressedImage( int quality, ChrominanceSubsampling::VALUE cs = ChrominanceSubsampling::CS_444 );
+        ImageJfif getCompressedDecompressedImage( int quality, ChrominanceSubsampling::VALUE cs, long long & compressedSize );
         void storeInFile( const std::string & path, int quality = 85, ChrominanceSubsampling::VALUE value = ChrominanceSubsampling::CS_444 );
         void storeInFile( const std::string & path, const ListOfMarkerShrdPtr & markers, int quality = 85, ChrominanceSubsampling::VALUE value = ChrominanceSubsampling::CS_444 );
         ImageJfif getImageWithChrominanceSubsampling( ChrominanceSubsampling::VALUE cs );
         ListOfMarkerShrdPtr getMarkers() { return m_listOfMarkers; }
+        ListOfQuantizationTableShrdPtr getQuantizationTables() const { return m_listOfQuantizationTables; }
+        ImageBufferShrdPtr getCompressedImageBuffer() const { return m_compressedImageBuffer; }
+
+        // an image loaded without decompression has a valid header only
+        bool isHeaderValid() const { return ( m_width > 0 ) && static_cast<bool>( m_compressedImageBuffer ); }
+        bool decompressImage();
+
+        // compression of the loaded file without decompressing the whole image;
+        // the file is transcoded one iMCU row after the other (see ImageJfif_strips.cpp);
+        // forStorage: optimized Huffman tables like TurboJPEG (TJ_OPTIMIZE), not needed for a comparison
+        ImageBufferShrdPtr compressInStrips( int quality, ChrominanceSubsampling::VALUE cs = ChrominanceSubsampling::CS_444, bool forStorage = true ) const;
+        void storeInFileInStrips( const std::string & path, int quality = 85, ChrominanceSubsampling::VALUE value = ChrominanceSubsampling::CS_444 );
+        void storeInFileInStrips( const std::string & path, const ListOfMarkerShrdPtr & markers, int quality = 85, ChrominanceSubsampling::VALUE value = ChrominanceSubsampling::CS_444 );
+
+        // estimates the IJG quality the source file was compressed with;
+        // returns 0 if the file contains no quantization tables
+        int estimateQuality() const;
+
+        // quantization table libjpeg uses for the given quality (id 0: luminance, else chrominance)
+        static QuantizationTableShrdPtr getStandardQuantizationTable( int quality, int id );
 
     protected:
 
     private:
-        void loadImage( const std::string & path );
+        void loadImage( const std::string & path, bool decompressNow );
+        void setCompressedImage( ImageBufferShrdPtr compressedImage, bool decompressNow );
+        static void writeFile( const std::string & path, ImageBufferShrdPtr compressedImage );
 
         ChrominanceSubsampling::VALUE convertTjJpegSubsamp( int value );
         Colorspace::VALUE convertTjJpegColorspace( int value );
         PixelFormat::VALUE convertTjPixelFormat( int value );
 
+        ImageJfif decompressHeader( ImageBufferShrdPtr compressedImage );
         ImageJfif decompress( ImageBufferShrdPtr compressedImage );
         ImageBufferShrdPtr compress( const ImageJfif & notCompressed, int quality = 85, ChrominanceSubsampling::VALUE cs = ChrominanceSubsampling::CS_444 );
 
@@ -102,7 +140,7 @@ class ImageJfif
         ImageJfif convertChrominanceSubsampling_444to420( const ImageJfif & image );
         ImageJfif convertChrominanceSubsampling_420to444( const ImageJfif & image );
 
-        ListOfMarkerShrdPtr copyMarkers( ImageBufferShrdPtr compressedImage );
+        ListOfMarkerShrdPtr copyMarkers( ImageBufferShrdPtr compressedImage, ListOfQuantizationTableShrdPtr & quantizationTables );
         ImageBufferShrdPtr enrichCompressedImageWithMakers( ImageBufferShrdPtr compressedImage, const ListOfMarkerShrdPtr & markers );
 
 }; //class
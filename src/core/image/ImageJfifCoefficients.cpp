@@ -0,0 +1,142 @@
+
+// include system headers
+#include <csetjmp>      // setjmp
+
+// include own headers
+#include "ImageJfifCoefficients.h"
+
+// include application headers
+#include "JpegErrorManager.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+ImageJfifCoefficients::ImageJfifCoefficients()
+: m_width( 0 )
+, m_height( 0 )
+, m_widthInBlocks( 0 )
+, m_heightInBlocks( 0 )
+, m_coefficients()
+{
+    reset();
+}
+
+ImageJfifCoefficients::ImageJfifCoefficients( ImageBufferShrdPtr compressedImage )
+: m_width( 0 )
+, m_height( 0 )
+, m_widthInBlocks( 0 )
+, m_heightInBlocks( 0 )
+, m_coefficients()
+{
+    reset();
+    readCoefficients( compressedImage );
+}
+
+void ImageJfifCoefficients::reset()
+{
+    m_width = 0;
+    m_height = 0;
+    m_widthInBlocks = 0;
+    m_heightInBlocks = 0;
+
+    for( int i = 0; i < 64; ++i )
+    {
+        m_quantizationTable[i] = 0;
+    }
+
+    m_coefficients.clear();
+}
+
+void ImageJfifCoefficients::readCoefficients( ImageBufferShrdPtr compressedImage )
+{
+    if(    ( !compressedImage )
+        || ( compressedImage->image == nullptr )
+        || ( compressedImage->size == 0 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "compressedImage is a nullptr" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerImage, "read DCT coefficients ..." );
+#endif //USE_LOG4CXX
+
+    struct jpeg_decompress_struct cinfo;
+    JpegErrorManager errorManager;
+
+    cinfo.err = jpeg_std_error( &errorManager.pub );
+    errorManager.pub.error_exit = jpegErrorExit;
+
+    if( setjmp( errorManager.setjmpBuffer ) )
+    {
+        jpeg_destroy_decompress( &cinfo );
+        reset();
+        return;
+    }
+
+    jpeg_create_decompress( &cinfo );
+    jpeg_mem_src( &cinfo, compressedImage->image, compressedImage->size );
+    jpeg_read_header( &cinfo, TRUE );
+
+    jvirt_barray_ptr * const coefficientArrays = jpeg_read_coefficients( &cinfo );
+    const jpeg_component_info * const luma = &cinfo.comp_info[0];
+
+    if(    ( coefficientArrays == nullptr )
+        || ( luma->quant_table == nullptr )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "no DCT coefficients available" );
+#endif //USE_LOG4CXX
+        jpeg_destroy_decompress( &cinfo );
+        return;
+    }
+
+    // the luminance component is never subsampled
+    m_width          = cinfo.image_width;
+    m_height         = cinfo.image_height;
+    m_widthInBlocks  = luma->width_in_blocks;
+    m_heightInBlocks = luma->height_in_blocks;
+
+    for( int i = 0; i < 64; ++i )
+    {
+        m_quantizationTable[i] = luma->quant_table->quantval[i];
+    }
+
+    m_coefficients.resize( 64 * m_widthInBlocks * m_heightInBlocks );
+
+    for( int yBlock = 0; yBlock < m_heightInBlocks; ++yBlock )
+    {
+        JBLOCKARRAY row = ( *cinfo.mem->access_virt_barray )( reinterpret_cast<j_common_ptr>( &cinfo ), coefficientArrays[0], yBlock, 1, FALSE );
+        short * const dst = &m_coefficients[ 64 * yBlock * m_widthInBlocks ];
+
+        for( int xBlock = 0; xBlock < m_widthInBlocks; ++xBlock )
+        {
+            for( int i = 0; i < 64; ++i )
+            {
+                dst[ 64 * xBlock + i ] = row[0][xBlock][i];
+            }
+        }
+    }
+
+    jpeg_finish_decompress( &cinfo );
+    jpeg_destroy_decompress( &cinfo );
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerImage, "read DCT coefficients ... done (" << m_widthInBlocks << " x " << m_heightInBlocks << " blocks)" );
+#endif //USE_LOG4CXX
+}
+
+} //namespace imageshrink
@@ -0,0 +1,73 @@
+
+#ifndef IMAGEJFIFCOEFFICIENTS_H_
+#define IMAGEJFIFCOEFFICIENTS_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+
+// include application headers
+#include "ImageBuffer.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class ImageJfifCoefficients;
+typedef std::shared_ptr<ImageJfifCoefficients> ImageJfifCoefficientsShrdPtr;
+typedef std::weak_ptr<ImageJfifCoefficients>   ImageJfifCoefficientsWkPtr;
+
+// declaration
+// quantized DCT coefficients of the luminance component of a JFIF file,
+// read without decoding the image
+class ImageJfifCoefficients
+: public std::enable_shared_from_this<ImageJfifCoefficients>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        ImageJfifCoefficients();
+        ImageJfifCoefficients( ImageBufferShrdPtr compressedImage );
+        virtual ~ImageJfifCoefficients() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        int                m_width;
+        int                m_height;
+        int                m_widthInBlocks;
+        int                m_heightInBlocks;
+
+        unsigned short     m_quantizationTable[64];   // natural order
+        std::vector<short> m_coefficients;            // 64 per block (natural order), blocks row by row
+
+    //********** METHODS **********
+    public:
+        int getWidth() const { return m_width; }
+        int getHeight() const { return m_height; }
+        int getWidthInBlocks() const { return m_widthInBlocks; }
+        int getHeightInBlocks() const { return m_heightInBlocks; }
+        const unsigned short * getQuantizationTable() const { return m_quantizationTable; }
+        const short * getBlock( int xBlock, int yBlock ) const { return &m_coefficients[ 64 * ( yBlock * m_widthInBlocks + xBlock ) ]; }
+        bool isValid() const { return !m_coefficients.empty(); }
+        void reset();
+
+    protected:
+
+    private:
+        void readCoefficients( ImageBufferShrdPtr compressedImage );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //IMAGEJFIFCOEFFICIENTS_H_
@@ -1,6 +1,6 @@
 
 // include system headers
-#include <string.h> // for memcpy
+#include <cstring> // for memcpy
 
 // include own headers
 #include "ImageJfif.h"
@@ -27,12 +27,72 @@ int getLengthOfMarker( const char * const & image, int & pos )
     const int ret = ( byte1 << 8 ) + ( byte2 );
     return ret;
 }
-    
-ImageJfif::ListOfMarkerShrdPtr ImageJfif::copyMarkers( ImageBufferShrdPtr compressedImage )
+
+// position within the 8x8 block (row-major) of the n-th zig-zag coefficient
+static const int naturalOrder[64] =
+{
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63
+};
+
+void parseQuantizationTables( const char * const & image, int pos, int length, ImageJfif::ListOfQuantizationTableShrdPtr & quantizationTables )
+{
+    // the length includes the two length bytes
+    const int end = pos + length;
+    pos += 2;
+
+    while( pos < end )
+    {
+        const int precisionAndId = static_cast<unsigned char>( image[ pos ] );
+        const bool is16Bit = ( ( precisionAndId >> 4 ) != 0 );
+        pos++;
+
+        if( ( pos + ( is16Bit ? 128 : 64 ) ) > end )
+        {
+#ifdef USE_LOG4CXX
+            LOG4CXX_ERROR( loggerImage, "DQT marker is too short" );
+#endif //USE_LOG4CXX
+            return;
+        }
+
+        ImageJfif::QuantizationTableShrdPtr table = std::make_shared< ImageJfif::QuantizationTable >();
+        table->id = precisionAndId & 0x0f;
+
+        for( int i = 0; i < 64; ++i )
+        {
+            if( is16Bit )
+            {
+                table->values[ naturalOrder[i] ] = ( static_cast<unsigned char>( image[ pos + 0 ] ) << 8 )
+                                                 + ( static_cast<unsigned char>( image[ pos + 1 ] ) );
+                pos += 2;
+            }
+            else
+            {
+                table->values[ naturalOrder[i] ] = static_cast<unsigned char>( image[ pos ] );
+                pos += 1;
+            }
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_DEBUG( loggerImage, "quantization table " << table->id << " found" );
+#endif //USE_LOG4CXX
+
+        quantizationTables.push_back( table );
+    }
+}
+
+ImageJfif::ListOfMarkerShrdPtr ImageJfif::copyMarkers( ImageBufferShrdPtr compressedImage, ListOfQuantizationTableShrdPtr & quantizationTables )
 {
     // preparation
     int pos = 0;
     ListOfMarkerShrdPtr retList;
+    quantizationTables.clear();
     
     if( !compressedImage )
     {
@@ -298,7 +358,9 @@ ImageJfif::ListOfMarkerShrdPtr ImageJfif::copyMarkers( ImageBufferShrdPtr compre
 #ifdef USE_LOG4CXX
             LOG4CXX_DEBUG( loggerImage, "DQT marker at possition 0x" << std::hex << ( pos - 2 ) << " detected (Define Quantization Table)" );
 #endif //USE_LOG4CXX
-            pos += getLengthOfMarker( image, pos );
+            const int length = getLengthOfMarker( image, pos );
+            parseQuantizationTables( image, pos, length, quantizationTables );
+            pos += length;
         }
         else if( marker == "\xff\xc0" )
         {
@@ -0,0 +1,118 @@
+
+// include system headers
+#include <cstdlib>      // std::abs
+#include <limits>       // std::numeric_limits<...>::...
+
+// include own headers
+#include "ImageJfif.h"
+
+// include application headers
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+// quantization tables of the JPEG standard (Annex K), natural order
+static const int standardLuminanceTable[64] =
+{
+    16,  11,  10,  16,  24,  40,  51,  61,
+    12,  12,  14,  19,  26,  58,  60,  55,
+    14,  13,  16,  24,  40,  57,  69,  56,
+    14,  17,  22,  29,  51,  87,  80,  62,
+    18,  22,  37,  56,  68, 109, 103,  77,
+    24,  35,  55,  64,  81, 104, 113,  92,
+    49,  64,  78,  87, 103, 121, 120, 101,
+    72,  92,  95,  98, 112, 100, 103,  99
+};
+
+static const int standardChrominanceTable[64] =
+{
+    17,  18,  24,  47,  99,  99,  99,  99,
+    18,  21,  26,  66,  99,  99,  99,  99,
+    24,  26,  56,  99,  99,  99,  99,  99,
+    47,  66,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99,
+    99,  99,  99,  99,  99,  99,  99,  99
+};
+
+// quantization value libjpeg uses for the given quality (baseline)
+static int getScaledQuantizationValue( int standardValue, int quality )
+{
+    const int scale = ( quality < 50 ) ? ( 5000 / quality ) : ( 200 - 2 * quality );
+    int value = ( standardValue * scale + 50 ) / 100;
+
+    if( value < 1 )   { value = 1; }
+    if( value > 255 ) { value = 255; }
+
+    return value;
+}
+
+ImageJfif::QuantizationTableShrdPtr ImageJfif::getStandardQuantizationTable( int quality, int id )
+{
+    QuantizationTableShrdPtr ret = std::make_shared<QuantizationTable>();
+    const int * const standardTable = ( id == 0 ) ? standardLuminanceTable : standardChrominanceTable;
+
+    ret->id = id;
+
+    for( int i = 0; i < 64; ++i )
+    {
+        ret->values[i] = getScaledQuantizationValue( standardTable[i], quality );
+    }
+
+    return ret;
+}
+
+int ImageJfif::estimateQuality() const
+{
+    int bestQuality = 0;
+    long bestDeviation = std::numeric_limits<long>::max();
+
+    if( m_listOfQuantizationTables.empty() )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_WARN( loggerImage, "no quantization tables available; quality can not be estimated" );
+#endif //USE_LOG4CXX
+        return bestQuality;
+    }
+
+    // compare the tables with the scaled standard tables;
+    // on equal deviation the higher quality wins
+    for( int quality = 100; quality >= 1; --quality )
+    {
+        long deviation = 0;
+
+        for( auto it = m_listOfQuantizationTables.begin(); it != m_listOfQuantizationTables.end(); ++it )
+        {
+            const QuantizationTableShrdPtr standardTable = getStandardQuantizationTable( quality, (*it)->id );
+
+            for( int i = 0; i < 64; ++i )
+            {
+                deviation += std::abs( (*it)->values[i] - standardTable->values[i] );
+            }
+        }
+
+        if( deviation < bestDeviation )
+        {
+            bestDeviation = deviation;
+            bestQuality = quality;
+        }
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerImage, "estimated quality = " << bestQuality << " (deviation = " << bestDeviation << ")" );
+#endif //USE_LOG4CXX
+
+    return bestQuality;
+}
+
+} //namespace imageshrink
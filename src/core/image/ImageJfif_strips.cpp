@@ -0,0 +1,254 @@
+
+// include system headers
+#include <algorithm>    // std::min
+#include <cstdlib>      // std::getenv
+#include <cstring>      // std::memcpy, std::strcmp
+#include <vector>
+
+// include own headers
+#include "ImageJfif.h"
+
+// include application headers
+#include "JpegStripDecoder.h"
+#include "JpegStripEncoder.h"
+#include "ChromaResampling.h"
+#include "ScopedTimer.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+// TurboJPEG optimizes the Huffman tables if TJ_OPTIMIZE is 1
+static bool isHuffmanOptimizationRequested()
+{
+    const char * const value = std::getenv( "TJ_OPTIMIZE" );
+
+    return ( value != nullptr ) && ( std::strcmp( value, "1" ) == 0 );
+}
+
+// decoder and encoder have the same rows; the lines are copied
+static bool copyRow( JpegStripDecoder & decoder, JpegStripEncoder & encoder )
+{
+    if( !decoder.readRow() )
+    {
+        return false;
+    }
+
+    for( int i = 0; i < encoder.getNofComponents(); ++i )
+    {
+        const int bytesPerLine = std::min( decoder.getBytesPerLine( i ), encoder.getBytesPerLine( i ) );
+
+        for( int line = 0; line < encoder.getLinesPerRow( i ); ++line )
+        {
+            std::memcpy( encoder.getLine( i, line ), decoder.getLine( i, line ), bytesPerLine );
+        }
+    }
+
+    return true;
+}
+
+// one row of the 4:2:0 image consists of two rows of the 4:4:4 image (strip);
+// the chroma borders are handled like convertChrominanceSubsampling_444to420()
+static bool downsampleRow( JpegStripDecoder & decoder, JpegStripEncoder & encoder, int row, std::vector<unsigned char> strip[3] )
+{
+    const int linesPerRowOld = decoder.getLinesPerRow( 0 );
+
+    for( int part = 0; part < 2; ++part )
+    {
+        // the lines of a missing second row are beyond the image
+        if( decoder.getNofRowsRead() == decoder.getNofRows() )
+        {
+            break;
+        }
+
+        if( !decoder.readRow() )
+        {
+            return false;
+        }
+
+        for( int i = 0; i < 3; ++i )
+        {
+            const int bytesPerLineOld = decoder.getBytesPerLine( i );
+
+            for( int line = 0; line < linesPerRowOld; ++line )
+            {
+                std::memcpy( &strip[i][ ( part * linesPerRowOld + line ) * bytesPerLineOld ], decoder.getLine( i, line ), bytesPerLineOld );
+            }
+        }
+    }
+
+    // copy luminance
+    {
+        const int bytesPerLineOld = decoder.getBytesPerLine( 0 );
+        const int bytesPerLine    = std::min( bytesPerLineOld, encoder.getBytesPerLine( 0 ) );
+
+        for( int line = 0; line < encoder.getLinesPerRow( 0 ); ++line )
+        {
+            std::memcpy( encoder.getLine( 0, line ), &strip[0][ line * bytesPerLineOld ], bytesPerLine );
+        }
+    }
+
+    // create U/Cb and V/Cr lines
+    const ChromaResamplingImplementation & resampling = getChromaResampling();
+
+    for( int i = 1; i < 3; ++i )
+    {
+        const int bytesPerLineOld = decoder.getBytesPerLine( i );
+        const int widthOld        = decoder.getPlaneWidth( i );
+        const int heightOld       = decoder.getPlaneHeight( i );
+        const int widthMainPart   = widthOld / 2;
+        const int linesPerRow     = encoder.getLinesPerRow( i );
+
+        for( int line = 0; line < linesPerRow; ++line )
+        {
+            const int yOld = ( row * linesPerRow + line ) * 2;
+
+            if( yOld >= heightOld )
+            {
+                break;
+            }
+
+            const unsigned char * const line0 = &strip[i][ ( line * 2 + 0 ) * bytesPerLineOld ];
+            const unsigned char * const line1 = &strip[i][ ( line * 2 + 1 ) * bytesPerLineOld ];
+            unsigned char * const lineNew = encoder.getLine( i, line );
+
+            if( ( yOld + 1 ) < heightOld )
+            {
+                resampling.downsample2x2( line0, line1, lineNew, widthMainPart );
+
+                // remaining part at the right side
+                if( ( widthOld % 2 ) != 0 )
+                {
+                    lineNew[ widthMainPart ] = ( line0[ widthOld - 1 ] + line1[ widthOld - 1 ] ) / 2;
+                }
+            }
+            else
+            {
+                // remaining part at the bottom
+                for( int x = 0; x < widthMainPart; ++x )
+                {
+                    lineNew[x] = ( line0[ 2 * x ] + line0[ 2 * x + 1 ] ) / 2;
+                }
+
+                // remaining pixel at the bottom right
+                if( ( widthOld % 2 ) != 0 )
+                {
+                    lineNew[ widthMainPart ] = line0[ widthOld - 1 ];
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+ImageBufferShrdPtr ImageJfif::compressInStrips( int quality, ChrominanceSubsampling::VALUE cs, bool forStorage ) const
+{
+    ScopedTimer timer( Stage::COMPRESS );
+    ImageBufferShrdPtr ret;
+
+    JpegStripDecoder decoder( m_compressedImageBuffer );
+
+    if( !decoder.isValid() )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "compressed image could not be decoded" );
+#endif //USE_LOG4CXX
+        return ret;
+    }
+
+    // like convertChrominanceSubsampling() only 4:4:4 to 4:2:0 is converted
+    const ChrominanceSubsampling::VALUE csOld = decoder.getChrominanceSubsampling();
+    const bool downsample = ( csOld == ChrominanceSubsampling::CS_444 ) && ( cs == ChrominanceSubsampling::CS_420 );
+
+    if(    ( csOld != cs )
+        && ( !downsample )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "chrominance subsampling not converted" );
+#endif //USE_LOG4CXX
+        return ret;
+    }
+
+    // the pixels of a candidate do not depend on the Huffman tables
+    JpegStripEncoder encoder( decoder.getWidth(), decoder.getHeight(), cs, quality, forStorage && isHuffmanOptimizationRequested() );
+
+    if( !encoder.isValid() )
+    {
+        return ret;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerImage, "compress image in " << encoder.getNofRows() << " strips ..." );
+#endif //USE_LOG4CXX
+
+    std::vector<unsigned char> strip[3];
+
+    if( downsample )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            strip[i].resize( 2 * decoder.getLinesPerRow( i ) * decoder.getBytesPerLine( i ) );
+        }
+    }
+
+    for( int row = 0; row < encoder.getNofRows(); ++row )
+    {
+        const bool rowRead = downsample ? downsampleRow( decoder, encoder, row, strip ) : copyRow( decoder, encoder );
+
+        if(    ( !rowRead )
+            || ( !encoder.writeRow() )
+          )
+        {
+#ifdef USE_LOG4CXX
+            LOG4CXX_ERROR( loggerImage, "strip " << row << " could not be transcoded" );
+#endif //USE_LOG4CXX
+            return ret;
+        }
+    }
+
+    ret = encoder.finish();
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerImage, "compress image in " << encoder.getNofRows() << " strips ... done" );
+#endif //USE_LOG4CXX
+
+    return ret;
+}
+
+void ImageJfif::storeInFileInStrips( const std::string & path, int quality, ChrominanceSubsampling::VALUE cs )
+{
+    // compress image
+    ImageBufferShrdPtr compressedImage = compressInStrips( quality, cs );
+
+    // write new image
+    writeFile( path, compressedImage );
+}
+
+void ImageJfif::storeInFileInStrips( const std::string & path, const ListOfMarkerShrdPtr & markers, int quality, ChrominanceSubsampling::VALUE cs )
+{
+    // compress image
+    ImageBufferShrdPtr compressedImage = compressInStrips( quality, cs );
+
+    if( !compressedImage )
+    {
+        return;
+    }
+
+    // enrich the compressed image with the markers
+    compressedImage = enrichCompressedImageWithMakers( compressedImage, markers );
+
+    // write new image
+    writeFile( path, compressedImage );
+}
+
+} //namespace imageshrink
@@ -0,0 +1,172 @@
+
+// include system headers
+#include <csetjmp>      // setjmp
+
+// include own headers
+#include "JpegStripDecoder.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+JpegStripDecoder::JpegStripDecoder( ImageBufferShrdPtr compressedImage )
+: m_compressedImage( compressedImage )
+, m_cinfo()
+, m_errorManager()
+, m_valid( false )
+, m_nofRowsRead( 0 )
+, m_lines()
+, m_linePointers()
+{
+    m_cinfo.err = jpeg_std_error( &m_errorManager.pub );
+    m_errorManager.pub.error_exit = jpegErrorExit;
+
+    jpeg_create_decompress( &m_cinfo );
+    readHeader();
+}
+
+JpegStripDecoder::~JpegStripDecoder()
+{
+    // the trailing markers are not of interest; so the decompression is not finished
+    jpeg_destroy_decompress( &m_cinfo );
+}
+
+void JpegStripDecoder::readHeader()
+{
+    if(    ( !m_compressedImage )
+        || ( m_compressedImage->image == nullptr )
+        || ( m_compressedImage->size == 0 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "compressedImage is a nullptr" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+    if( setjmp( m_errorManager.setjmpBuffer ) )
+    {
+        m_valid = false;
+        return;
+    }
+
+    jpeg_mem_src( &m_cinfo, m_compressedImage->image, m_compressedImage->size );
+    jpeg_read_header( &m_cinfo, TRUE );
+
+    // same settings as tjDecompressToYUV2() with TJFLAG_ACCURATEDCT
+    m_cinfo.raw_data_out = TRUE;
+    m_cinfo.dct_method   = JDCT_ISLOW;
+
+    jpeg_start_decompress( &m_cinfo );
+
+    m_lines.resize( m_cinfo.num_components );
+    m_linePointers.resize( m_cinfo.num_components );
+
+    for( int i = 0; i < m_cinfo.num_components; ++i )
+    {
+        const int linesPerRow  = getLinesPerRow( i );
+        const int bytesPerLine = getBytesPerLine( i );
+
+        m_lines[i].resize( linesPerRow * bytesPerLine );
+        m_linePointers[i].resize( linesPerRow );
+
+        for( int line = 0; line < linesPerRow; ++line )
+        {
+            m_linePointers[i][ line ] = &m_lines[i][ line * bytesPerLine ];
+        }
+    }
+
+    m_valid = true;
+}
+
+ChrominanceSubsampling::VALUE JpegStripDecoder::getChrominanceSubsampling() const
+{
+    if( m_cinfo.num_components == 1 )
+    {
+        return ChrominanceSubsampling::Gray;
+    }
+
+    if(    ( m_cinfo.num_components != 3 )
+        || ( m_cinfo.comp_info[1].h_samp_factor != 1 ) || ( m_cinfo.comp_info[1].v_samp_factor != 1 )
+        || ( m_cinfo.comp_info[2].h_samp_factor != 1 ) || ( m_cinfo.comp_info[2].v_samp_factor != 1 )
+      )
+    {
+        return ChrominanceSubsampling::UNKNOWN;
+    }
+
+    const int samplingX = m_cinfo.comp_info[0].h_samp_factor;
+    const int samplingY = m_cinfo.comp_info[0].v_samp_factor;
+
+    if( ( samplingX == 1 ) && ( samplingY == 1 ) ) return ChrominanceSubsampling::CS_444;
+    if( ( samplingX == 2 ) && ( samplingY == 1 ) ) return ChrominanceSubsampling::CS_422;
+    if( ( samplingX == 2 ) && ( samplingY == 2 ) ) return ChrominanceSubsampling::CS_420;
+    if( ( samplingX == 1 ) && ( samplingY == 2 ) ) return ChrominanceSubsampling::CS_440;
+    if( ( samplingX == 4 ) && ( samplingY == 1 ) ) return ChrominanceSubsampling::CS_411;
+
+    return ChrominanceSubsampling::UNKNOWN;
+}
+
+int JpegStripDecoder::getPlaneWidth( int component ) const
+{
+    const int maxSamplingX = m_cinfo.max_h_samp_factor;
+    const int paddedWidth  = ( ( getWidth() + maxSamplingX - 1 ) / maxSamplingX ) * maxSamplingX;
+
+    return ( paddedWidth * m_cinfo.comp_info[ component ].h_samp_factor ) / maxSamplingX;
+}
+
+int JpegStripDecoder::getPlaneHeight( int component ) const
+{
+    const int maxSamplingY = m_cinfo.max_v_samp_factor;
+    const int paddedHeight = ( ( getHeight() + maxSamplingY - 1 ) / maxSamplingY ) * maxSamplingY;
+
+    return ( paddedHeight * m_cinfo.comp_info[ component ].v_samp_factor ) / maxSamplingY;
+}
+
+bool JpegStripDecoder::readRow()
+{
+    if(    ( !m_valid )
+        || ( m_nofRowsRead >= getNofRows() )
+      )
+    {
+        return false;
+    }
+
+    if( setjmp( m_errorManager.setjmpBuffer ) )
+    {
+        m_valid = false;
+        return false;
+    }
+
+    JSAMPARRAY components[ MAX_COMPONENTS ];
+
+    for( int i = 0; i < m_cinfo.num_components; ++i )
+    {
+        components[i] = &m_linePointers[i][0];
+    }
+
+    if( jpeg_read_raw_data( &m_cinfo, components, m_cinfo.max_v_samp_factor * DCTSIZE ) == 0 )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "row " << m_nofRowsRead << " could not be decoded" );
+#endif //USE_LOG4CXX
+        m_valid = false;
+        return false;
+    }
+
+    m_nofRowsRead++;
+
+    return true;
+}
+
+} //namespace imageshrink
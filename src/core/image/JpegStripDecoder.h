@@ -0,0 +1,89 @@
+
+#ifndef JPEGSTRIPDECODER_H_
+#define JPEGSTRIPDECODER_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+
+// include application headers
+#include "ImageBuffer.h"
+#include "JpegErrorManager.h"
+#include "enumChrominanceSubsampling.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class JpegStripDecoder;
+typedef std::shared_ptr<JpegStripDecoder> JpegStripDecoderShrdPtr;
+typedef std::weak_ptr<JpegStripDecoder>   JpegStripDecoderWkPtr;
+
+// declaration
+// decodes a JFIF image one iMCU row after the other into raw planes (like
+// tjDecompressToYUV2: no colour conversion, no upsampling); only the lines
+// of the current row are kept in memory
+class JpegStripDecoder
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        JpegStripDecoder( ImageBufferShrdPtr compressedImage );
+        virtual ~JpegStripDecoder();
+
+    protected:
+
+    private:
+        JpegStripDecoder( const JpegStripDecoder & );               // not copyable
+        JpegStripDecoder & operator=( const JpegStripDecoder & );   // not copyable
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        ImageBufferShrdPtr                 m_compressedImage;
+        struct jpeg_decompress_struct      m_cinfo;
+        JpegErrorManager                   m_errorManager;
+        bool                               m_valid;
+        int                                m_nofRowsRead;
+
+        std::vector< std::vector<unsigned char> > m_lines;      // per component: the lines of the current row
+        std::vector< std::vector<JSAMPROW> >      m_linePointers;
+
+    //********** METHODS **********
+    public:
+        bool isValid() const { return m_valid; }
+        int getWidth() const { return m_cinfo.image_width; }
+        int getHeight() const { return m_cinfo.image_height; }
+        ChrominanceSubsampling::VALUE getChrominanceSubsampling() const;
+
+        int getNofComponents() const { return m_cinfo.num_components; }
+        int getNofRows() const { return m_cinfo.total_iMCU_rows; }
+        int getNofRowsRead() const { return m_nofRowsRead; }
+        int getLinesPerRow( int component ) const { return m_cinfo.comp_info[ component ].v_samp_factor * DCTSIZE; }
+        int getBytesPerLine( int component ) const { return m_cinfo.comp_info[ component ].width_in_blocks * DCTSIZE; }
+
+        // size of the plane TurboJPEG uses (tjPlaneWidth(), tjPlaneHeight())
+        int getPlaneWidth( int component ) const;
+        int getPlaneHeight( int component ) const;
+
+        // decodes the next row; false after the last row or on errors
+        bool readRow();
+
+        // line of the current row (0 <= line < getLinesPerRow())
+        const unsigned char * getLine( int component, int line ) const { return m_linePointers[ component ][ line ]; }
+
+    protected:
+
+    private:
+        void readHeader();
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //JPEGSTRIPDECODER_H_
@@ -0,0 +1,280 @@
+
+// include system headers
+#include <algorithm>    // std::min, std::max
+#include <csetjmp>      // setjmp
+#include <cstring>      // std::memcpy, std::memset
+
+// include own headers
+#include "JpegStripEncoder.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+static const std::size_t destinationBlockSize = 64 * 1024;   // bytes
+
+JpegStripEncoder::JpegStripEncoder( int width, int height, ChrominanceSubsampling::VALUE cs, int quality, bool optimizeCoding )
+: m_cinfo()
+, m_errorManager()
+, m_destination()
+, m_compressed()
+, m_valid( false )
+, m_nofRowsWritten( 0 )
+, m_lines()
+, m_linePointers()
+{
+    m_cinfo.err = jpeg_std_error( &m_errorManager.pub );
+    m_errorManager.pub.error_exit = jpegErrorExit;
+
+    jpeg_create_compress( &m_cinfo );
+    startCompression( width, height, cs, quality, optimizeCoding );
+}
+
+JpegStripEncoder::~JpegStripEncoder()
+{
+    jpeg_destroy_compress( &m_cinfo );
+}
+
+void JpegStripEncoder::initDestination( j_compress_ptr cinfo )
+{
+    Destination * const destination = reinterpret_cast<Destination *>( cinfo->dest );
+
+    destination->buffer->resize( destinationBlockSize );
+    destination->pub.next_output_byte = &( *destination->buffer )[0];
+    destination->pub.free_in_buffer   = destination->buffer->size();
+}
+
+boolean JpegStripEncoder::emptyOutputBuffer( j_compress_ptr cinfo )
+{
+    Destination * const destination = reinterpret_cast<Destination *>( cinfo->dest );
+
+    // libjpeg expects the whole buffer to be emptied
+    const std::size_t used = destination->buffer->size();
+
+    destination->buffer->resize( used + std::max( used, destinationBlockSize ) );
+    destination->pub.next_output_byte = &( *destination->buffer )[ used ];
+    destination->pub.free_in_buffer   = destination->buffer->size() - used;
+
+    return TRUE;
+}
+
+void JpegStripEncoder::termDestination( j_compress_ptr cinfo )
+{
+    Destination * const destination = reinterpret_cast<Destination *>( cinfo->dest );
+
+    destination->buffer->resize( destination->buffer->size() - destination->pub.free_in_buffer );
+}
+
+void JpegStripEncoder::startCompression( int width, int height, ChrominanceSubsampling::VALUE cs, int quality, bool optimizeCoding )
+{
+    int samplingX = 0;
+    int samplingY = 0;
+
+    switch( cs )
+    {
+        case ChrominanceSubsampling::CS_444: samplingX = 1; samplingY = 1; break;
+        case ChrominanceSubsampling::CS_422: samplingX = 2; samplingY = 1; break;
+        case ChrominanceSubsampling::CS_420: samplingX = 2; samplingY = 2; break;
+        case ChrominanceSubsampling::CS_440: samplingX = 1; samplingY = 2; break;
+        case ChrominanceSubsampling::CS_411: samplingX = 4; samplingY = 1; break;
+        case ChrominanceSubsampling::Gray:   samplingX = 1; samplingY = 1; break;
+        default:
+            /* nothing */
+            break;
+    }
+
+    if(    ( samplingX == 0 )
+        || ( width <= 0 )
+        || ( height <= 0 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "chrominance subsampling " << ChrominanceSubsampling::toString( cs ) << " or size " << width << " x " << height << " not supported" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+    if( setjmp( m_errorManager.setjmpBuffer ) )
+    {
+        m_valid = false;
+        return;
+    }
+
+    m_destination.pub.init_destination    = initDestination;
+    m_destination.pub.empty_output_buffer = emptyOutputBuffer;
+    m_destination.pub.term_destination    = termDestination;
+    m_destination.buffer                  = &m_compressed;
+    m_cinfo.dest = &m_destination.pub;
+
+    // same settings as tjCompressFromYUV() with TJFLAG_ACCURATEDCT
+    m_cinfo.image_width      = width;
+    m_cinfo.image_height     = height;
+    m_cinfo.in_color_space   = ( cs == ChrominanceSubsampling::Gray ) ? JCS_GRAYSCALE : JCS_YCbCr;
+    m_cinfo.input_components = ( cs == ChrominanceSubsampling::Gray ) ? 1 : 3;
+
+    jpeg_set_defaults( &m_cinfo );
+    jpeg_set_quality( &m_cinfo, quality, TRUE );
+    m_cinfo.dct_method      = JDCT_ISLOW;
+    m_cinfo.optimize_coding = optimizeCoding ? TRUE : FALSE;
+    jpeg_set_colorspace( &m_cinfo, ( cs == ChrominanceSubsampling::Gray ) ? JCS_GRAYSCALE : JCS_YCbCr );
+
+    m_cinfo.comp_info[0].h_samp_factor = samplingX;
+    m_cinfo.comp_info[0].v_samp_factor = samplingY;
+
+    for( int i = 1; i < m_cinfo.num_components; ++i )
+    {
+        m_cinfo.comp_info[i].h_samp_factor = 1;
+        m_cinfo.comp_info[i].v_samp_factor = 1;
+    }
+
+    m_cinfo.raw_data_in = TRUE;
+
+    jpeg_start_compress( &m_cinfo, TRUE );
+
+    m_lines.resize( m_cinfo.num_components );
+    m_linePointers.resize( m_cinfo.num_components );
+
+    for( int i = 0; i < m_cinfo.num_components; ++i )
+    {
+        const int linesPerRow  = getLinesPerRow( i );
+        const int bytesPerLine = getBytesPerLine( i );
+
+        m_lines[i].resize( linesPerRow * bytesPerLine );
+        m_linePointers[i].resize( linesPerRow );
+
+        for( int line = 0; line < linesPerRow; ++line )
+        {
+            m_linePointers[i][ line ] = &m_lines[i][ line * bytesPerLine ];
+        }
+    }
+
+    m_valid = true;
+}
+
+int JpegStripEncoder::getNofRows() const
+{
+    const int linesPerRow = m_cinfo.max_v_samp_factor * DCTSIZE;
+
+    return ( m_cinfo.image_height + linesPerRow - 1 ) / linesPerRow;
+}
+
+int JpegStripEncoder::getPlaneWidth( int component ) const
+{
+    const int maxSamplingX = m_cinfo.max_h_samp_factor;
+    const int paddedWidth  = ( ( m_cinfo.image_width + maxSamplingX - 1 ) / maxSamplingX ) * maxSamplingX;
+
+    return ( paddedWidth * m_cinfo.comp_info[ component ].h_samp_factor ) / maxSamplingX;
+}
+
+int JpegStripEncoder::getPlaneHeight( int component ) const
+{
+    const int maxSamplingY = m_cinfo.max_v_samp_factor;
+    const int paddedHeight = ( ( m_cinfo.image_height + maxSamplingY - 1 ) / maxSamplingY ) * maxSamplingY;
+
+    return ( paddedHeight * m_cinfo.comp_info[ component ].v_samp_factor ) / maxSamplingY;
+}
+
+void JpegStripEncoder::replicateBorders()
+{
+    for( int i = 0; i < m_cinfo.num_components; ++i )
+    {
+        const int linesPerRow  = getLinesPerRow( i );
+        const int bytesPerLine = getBytesPerLine( i );
+        const int planeWidth   = getPlaneWidth( i );
+        const int validLines   = std::min( linesPerRow, getPlaneHeight( i ) - m_nofRowsWritten * linesPerRow );
+
+        // duplicate the last sample of each line
+        for( int line = 0; line < validLines; ++line )
+        {
+            unsigned char * const pixels = m_linePointers[i][ line ];
+
+            std::memset( &pixels[ planeWidth ], pixels[ planeWidth - 1 ], bytesPerLine - planeWidth );
+        }
+
+        // duplicate the last line
+        for( int line = validLines; line < linesPerRow; ++line )
+        {
+            std::memcpy( m_linePointers[i][ line ], m_linePointers[i][ validLines - 1 ], bytesPerLine );
+        }
+    }
+}
+
+bool JpegStripEncoder::writeRow()
+{
+    if(    ( !m_valid )
+        || ( m_nofRowsWritten >= getNofRows() )
+      )
+    {
+        return false;
+    }
+
+    replicateBorders();
+
+    if( setjmp( m_errorManager.setjmpBuffer ) )
+    {
+        m_valid = false;
+        return false;
+    }
+
+    JSAMPARRAY components[ MAX_COMPONENTS ];
+
+    for( int i = 0; i < m_cinfo.num_components; ++i )
+    {
+        components[i] = &m_linePointers[i][0];
+    }
+
+    if( jpeg_write_raw_data( &m_cinfo, components, m_cinfo.max_v_samp_factor * DCTSIZE ) == 0 )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "row " << m_nofRowsWritten << " could not be encoded" );
+#endif //USE_LOG4CXX
+        m_valid = false;
+        return false;
+    }
+
+    m_nofRowsWritten++;
+
+    return true;
+}
+
+ImageBufferShrdPtr JpegStripEncoder::finish()
+{
+    ImageBufferShrdPtr ret;
+
+    if(    ( !m_valid )
+        || ( m_nofRowsWritten != getNofRows() )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "compression not complete (" << m_nofRowsWritten << " of " << getNofRows() << " rows)" );
+#endif //USE_LOG4CXX
+        return ret;
+    }
+
+    if( setjmp( m_errorManager.setjmpBuffer ) )
+    {
+        m_valid = false;
+        return ret;
+    }
+
+    jpeg_finish_compress( &m_cinfo );
+    m_valid = false;
+
+    ret = std::make_shared<ImageBuffer>( m_compressed.size() );
+    std::memcpy( ret->image, &m_compressed[0], m_compressed.size() );
+
+    return ret;
+}
+
+} //namespace imageshrink
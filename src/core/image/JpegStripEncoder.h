@@ -0,0 +1,105 @@
+
+#ifndef JPEGSTRIPENCODER_H_
+#define JPEGSTRIPENCODER_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+
+// include application headers
+#include "ImageBuffer.h"
+#include "JpegErrorManager.h"
+#include "enumChrominanceSubsampling.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class JpegStripEncoder;
+typedef std::shared_ptr<JpegStripEncoder> JpegStripEncoderShrdPtr;
+typedef std::weak_ptr<JpegStripEncoder>   JpegStripEncoderWkPtr;
+
+// declaration
+// compresses raw planes one iMCU row after the other into memory with the
+// settings of tjCompressFromYUV() (TJFLAG_ACCURATEDCT); the lines of the
+// plane TurboJPEG uses are filled by the caller, the padding up to the
+// blocks is replicated from the last column and line like TurboJPEG does;
+// optimized Huffman tables need two passes, so libjpeg keeps the DCT
+// coefficients of the whole image then (2 bytes per sample)
+class JpegStripEncoder
+{
+    //********** PRELIMINARY **********
+    public:
+
+    private:
+        // appends the compressed data to m_compressed
+        struct Destination
+        {
+            struct jpeg_destination_mgr  pub;
+            std::vector<unsigned char> * buffer;
+        };
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        JpegStripEncoder( int width, int height, ChrominanceSubsampling::VALUE cs, int quality, bool optimizeCoding = false );
+        virtual ~JpegStripEncoder();
+
+    protected:
+
+    private:
+        JpegStripEncoder( const JpegStripEncoder & );               // not copyable
+        JpegStripEncoder & operator=( const JpegStripEncoder & );   // not copyable
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        struct jpeg_compress_struct        m_cinfo;
+        JpegErrorManager                   m_errorManager;
+        Destination                        m_destination;
+        std::vector<unsigned char>         m_compressed;
+        bool                               m_valid;
+        int                                m_nofRowsWritten;
+
+        std::vector< std::vector<unsigned char> > m_lines;      // per component: the lines of the current row
+        std::vector< std::vector<JSAMPROW> >      m_linePointers;
+
+    //********** METHODS **********
+    public:
+        bool isValid() const { return m_valid; }
+
+        int getNofComponents() const { return m_cinfo.num_components; }
+        int getNofRows() const;
+        int getLinesPerRow( int component ) const { return m_cinfo.comp_info[ component ].v_samp_factor * DCTSIZE; }
+        int getBytesPerLine( int component ) const { return m_cinfo.comp_info[ component ].width_in_blocks * DCTSIZE; }
+
+        // size of the plane TurboJPEG uses (tjPlaneWidth(), tjPlaneHeight())
+        int getPlaneWidth( int component ) const;
+        int getPlaneHeight( int component ) const;
+
+        // line of the current row (0 <= line < getLinesPerRow())
+        unsigned char * getLine( int component, int line ) { return m_linePointers[ component ][ line ]; }
+
+        // compresses the current row; false on errors
+        bool writeRow();
+
+        // the compressed image after the last row; nullptr on errors
+        ImageBufferShrdPtr finish();
+
+    protected:
+
+    private:
+        void startCompression( int width, int height, ChrominanceSubsampling::VALUE cs, int quality, bool optimizeCoding );
+        void replicateBorders();
+
+        static void initDestination( j_compress_ptr cinfo );
+        static boolean emptyOutputBuffer( j_compress_ptr cinfo );
+        static void termDestination( j_compress_ptr cinfo );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //JPEGSTRIPENCODER_H_
@@ -0,0 +1,139 @@
+
+// include system headers
+#include <cstdlib>      // free
+
+// include own headers
+#include "BufferPool.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+BufferPool::BufferPool()
+: m_mutex()
+, m_freeBlocks()
+, m_freeBytes( 0 )
+, m_maxFreeBytes( maxFreeBytes_default )
+, m_nofHits( 0 )
+, m_nofMisses( 0 )
+{
+    // nothing
+}
+
+BufferPool & BufferPool::getInstance()
+{
+    static BufferPool * const instance = new BufferPool();
+
+    return *instance;
+}
+
+std::size_t BufferPool::getBlockSize( std::size_t size )
+{
+    std::size_t blockSize = minBlockSize;
+
+    while( blockSize < size )
+    {
+        blockSize *= 2;
+    }
+
+    return blockSize;
+}
+
+ImageBufferShrdPtr BufferPool::getBuffer( std::size_t size )
+{
+    const std::size_t blockSize = getBlockSize( size );
+    unsigned char * block = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        std::vector<unsigned char *> & freeBlocks = m_freeBlocks[ blockSize ];
+
+        if( !freeBlocks.empty() )
+        {
+            block = freeBlocks.back();
+            freeBlocks.pop_back();
+            m_freeBytes -= blockSize;
+        }
+    }
+
+    const bool hit = ( block != nullptr );
+
+    if( hit )
+    {
+        ++m_nofHits;
+    }
+    else
+    {
+        ++m_nofMisses;
+        block = ImageBuffer::allocate( blockSize );
+    }
+
+    StatsRecord * const record = StatsRecord::getCurrent();
+
+    if( record != nullptr )
+    {
+        record->addPoolRequest( hit );
+    }
+
+    return std::make_shared<ImageBuffer>(
+        block,
+        size,
+        [this, blockSize]( unsigned char * image ) { release( image, blockSize ); }
+    );
+}
+
+void BufferPool::release( unsigned char * block, std::size_t blockSize )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( m_freeBytes + blockSize <= m_maxFreeBytes )
+        {
+            m_freeBlocks[ blockSize ].push_back( block );
+            m_freeBytes += blockSize;
+            return;
+        }
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_DEBUG( loggerImage, "buffer pool is full, block of " << blockSize << " Bytes is freed" );
+#endif //USE_LOG4CXX
+
+    free( block );
+}
+
+void BufferPool::setMaxFreeBytes( std::size_t maxFreeBytes )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_maxFreeBytes = maxFreeBytes;
+}
+
+void BufferPool::clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    for( auto it = m_freeBlocks.begin(); it != m_freeBlocks.end(); ++it )
+    {
+        for( unsigned char * block : it->second )
+        {
+            free( block );
+        }
+    }
+
+    m_freeBlocks.clear();
+    m_freeBytes = 0;
+}
+
+} //namespace imageshrink
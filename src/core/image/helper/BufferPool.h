@@ -0,0 +1,81 @@
+
+#ifndef BUFFERPOOL_H_
+#define BUFFERPOOL_H_
+
+// include system headers
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// include application headers
+#include "ImageBuffer.h"
+
+namespace imageshrink
+{
+
+// declaration
+// recycles the memory of the frames every candidate quality needs
+// (decompressed, chroma converted and intermediate images); blocks are
+// grouped in power of two size classes, so equally sized frames of later
+// iterations get the pages that are mapped already
+class BufferPool
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+
+    protected:
+
+    private:
+        BufferPool();
+        BufferPool( const BufferPool & );               // not copyable
+        BufferPool & operator=( const BufferPool & );   // not copyable
+        virtual ~BufferPool() {}                        // never destroyed
+
+    //********** ATTRIBUTES **********
+    public:
+        static const std::size_t minBlockSize = 4096;             // bytes
+        static const std::size_t maxFreeBytes_default = 1 << 30;  // bytes kept for reuse
+
+    protected:
+
+    private:
+        std::mutex                                         m_mutex;
+        std::map<std::size_t, std::vector<unsigned char *> > m_freeBlocks;   // by block size
+        std::size_t                                        m_freeBytes;
+        std::size_t                                        m_maxFreeBytes;
+
+        std::atomic<long long>                             m_nofHits;
+        std::atomic<long long>                             m_nofMisses;
+
+    //********** METHODS **********
+    public:
+        // the pool lives until the end of the process, since buffers may
+        // be released by static or thread local objects
+        static BufferPool & getInstance();
+
+        // uninitialized, aligned buffer; the memory returns to the pool when
+        // the last reference is gone; thread safe
+        ImageBufferShrdPtr getBuffer( std::size_t size );
+
+        long long getNofHits() const { return m_nofHits; }
+        long long getNofMisses() const { return m_nofMisses; }
+
+        void setMaxFreeBytes( std::size_t maxFreeBytes );
+        void clear();   // releases all free blocks
+
+    protected:
+
+    private:
+        static std::size_t getBlockSize( std::size_t size );
+        void release( unsigned char * block, std::size_t blockSize );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //BUFFERPOOL_H_
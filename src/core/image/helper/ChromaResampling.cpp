@@ -0,0 +1,208 @@
+
+// include system headers
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CHROMARESAMPLING_X86
+#include <immintrin.h>
+#endif
+
+// include own headers
+#include "ChromaResampling.h"
+
+namespace imageshrink
+{
+
+//********** scalar **********
+
+static void downsample2x2_scalar( const unsigned char * line0, const unsigned char * line1, unsigned char * out, int nofOutPixels )
+{
+    for( int x = 0; x < nofOutPixels; ++x )
+    {
+        const int sum = line0[ 2 * x ] + line0[ 2 * x + 1 ] + line1[ 2 * x ] + line1[ 2 * x + 1 ];
+        out[x] = sum / 4;
+    }
+}
+
+static void upsample2x_scalar( const unsigned char * in, unsigned char * out, int nofInPixels )
+{
+    for( int x = 0; x < nofInPixels; ++x )
+    {
+        out[ 2 * x + 0 ] = in[x];
+        out[ 2 * x + 1 ] = in[x];
+    }
+}
+
+#ifdef CHROMARESAMPLING_X86
+
+//********** SSE2 **********
+
+// sums of the horizontal byte pairs of a vector as 16 bit values
+__attribute__((target("sse2")))
+static inline __m128i pairSums_sse2( __m128i v )
+{
+    const __m128i lowBytes = _mm_set1_epi16( 0x00FF );
+    return _mm_add_epi16( _mm_and_si128( v, lowBytes ), _mm_srli_epi16( v, 8 ) );
+}
+
+__attribute__((target("sse2")))
+static void downsample2x2_sse2( const unsigned char * line0, const unsigned char * line1, unsigned char * out, int nofOutPixels )
+{
+    int x = 0;
+
+    // 16 output pixels per iteration; the sums fit into 16 bit (4 * 255)
+    for( ; x + 16 <= nofOutPixels; x += 16 )
+    {
+        const __m128i a0 = _mm_loadu_si128( reinterpret_cast<const __m128i *>( &line0[ 2 * x ] ) );
+        const __m128i a1 = _mm_loadu_si128( reinterpret_cast<const __m128i *>( &line0[ 2 * x + 16 ] ) );
+        const __m128i b0 = _mm_loadu_si128( reinterpret_cast<const __m128i *>( &line1[ 2 * x ] ) );
+        const __m128i b1 = _mm_loadu_si128( reinterpret_cast<const __m128i *>( &line1[ 2 * x + 16 ] ) );
+
+        const __m128i sum0 = _mm_srli_epi16( _mm_add_epi16( pairSums_sse2( a0 ), pairSums_sse2( b0 ) ), 2 );
+        const __m128i sum1 = _mm_srli_epi16( _mm_add_epi16( pairSums_sse2( a1 ), pairSums_sse2( b1 ) ), 2 );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( &out[x] ), _mm_packus_epi16( sum0, sum1 ) );
+    }
+
+    downsample2x2_scalar( &line0[ 2 * x ], &line1[ 2 * x ], &out[x], nofOutPixels - x );
+}
+
+__attribute__((target("sse2")))
+static void upsample2x_sse2( const unsigned char * in, unsigned char * out, int nofInPixels )
+{
+    int x = 0;
+
+    for( ; x + 16 <= nofInPixels; x += 16 )
+    {
+        const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i *>( &in[x] ) );
+
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( &out[ 2 * x ] ),      _mm_unpacklo_epi8( v, v ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( &out[ 2 * x + 16 ] ), _mm_unpackhi_epi8( v, v ) );
+    }
+
+    upsample2x_scalar( &in[x], &out[ 2 * x ], nofInPixels - x );
+}
+
+//********** AVX2 **********
+
+__attribute__((target("avx2")))
+static inline __m256i pairSums_avx2( __m256i v )
+{
+    const __m256i lowBytes = _mm256_set1_epi16( 0x00FF );
+    return _mm256_add_epi16( _mm256_and_si256( v, lowBytes ), _mm256_srli_epi16( v, 8 ) );
+}
+
+__attribute__((target("avx2")))
+static void downsample2x2_avx2( const unsigned char * line0, const unsigned char * line1, unsigned char * out, int nofOutPixels )
+{
+    int x = 0;
+
+    // 32 output pixels per iteration
+    for( ; x + 32 <= nofOutPixels; x += 32 )
+    {
+        const __m256i a0 = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( &line0[ 2 * x ] ) );
+        const __m256i a1 = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( &line0[ 2 * x + 32 ] ) );
+        const __m256i b0 = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( &line1[ 2 * x ] ) );
+        const __m256i b1 = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( &line1[ 2 * x + 32 ] ) );
+
+        const __m256i sum0 = _mm256_srli_epi16( _mm256_add_epi16( pairSums_avx2( a0 ), pairSums_avx2( b0 ) ), 2 );
+        const __m256i sum1 = _mm256_srli_epi16( _mm256_add_epi16( pairSums_avx2( a1 ), pairSums_avx2( b1 ) ), 2 );
+
+        // packus works per 128 bit lane; restore the order of the quadwords
+        const __m256i packed = _mm256_permute4x64_epi64( _mm256_packus_epi16( sum0, sum1 ), 0xD8 );
+
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( &out[x] ), packed );
+    }
+
+    downsample2x2_sse2( &line0[ 2 * x ], &line1[ 2 * x ], &out[x], nofOutPixels - x );
+}
+
+__attribute__((target("avx2")))
+static void upsample2x_avx2( const unsigned char * in, unsigned char * out, int nofInPixels )
+{
+    int x = 0;
+
+    for( ; x + 32 <= nofInPixels; x += 32 )
+    {
+        // unpack works per 128 bit lane; pre-arrange the quadwords
+        const __m256i v = _mm256_permute4x64_epi64( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( &in[x] ) ), 0xD8 );
+
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( &out[ 2 * x ] ),      _mm256_unpacklo_epi8( v, v ) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( &out[ 2 * x + 32 ] ), _mm256_unpackhi_epi8( v, v ) );
+    }
+
+    upsample2x_sse2( &in[x], &out[ 2 * x ], nofInPixels - x );
+}
+
+#endif //CHROMARESAMPLING_X86
+
+//********** dispatching **********
+
+static const ChromaResamplingImplementation implementations[] =
+{
+#ifdef CHROMARESAMPLING_X86
+    { "avx2",   downsample2x2_avx2,   upsample2x_avx2 },
+    { "sse2",   downsample2x2_sse2,   upsample2x_sse2 },
+#endif //CHROMARESAMPLING_X86
+    { "scalar", downsample2x2_scalar, upsample2x_scalar }
+};
+
+static const int nofImplementations = sizeof( implementations ) / sizeof( implementations[0] );
+
+static bool isSupported( const ChromaResamplingImplementation & implementation )
+{
+#ifdef CHROMARESAMPLING_X86
+    __builtin_cpu_init();
+
+    if( implementation.downsample2x2 == downsample2x2_avx2 )
+    {
+        return __builtin_cpu_supports( "avx2" );
+    }
+
+    if( implementation.downsample2x2 == downsample2x2_sse2 )
+    {
+        return __builtin_cpu_supports( "sse2" );
+    }
+#endif //CHROMARESAMPLING_X86
+
+    return true;
+}
+
+// indices of the supported implementations, best first
+static const std::vector<int> & getSupportedImplementations()
+{
+    // determined once (thread safe initialization of local statics)
+    static const std::vector<int> supported = []()
+    {
+        std::vector<int> ret;
+
+        for( int i = 0; i < nofImplementations; ++i )
+        {
+            if( isSupported( implementations[i] ) )
+            {
+                ret.push_back( i );
+            }
+        }
+
+        return ret;
+    }();
+
+    return supported;
+}
+
+int getNofChromaResamplingImplementations()
+{
+    return getSupportedImplementations().size();
+}
+
+const ChromaResamplingImplementation & getChromaResamplingImplementation( int index )
+{
+    return implementations[ getSupportedImplementations()[ index ] ];
+}
+
+const ChromaResamplingImplementation & getChromaResampling()
+{
+    return getChromaResamplingImplementation( 0 );
+}
+
+} //namespace imageshrink
@@ -0,0 +1,29 @@
+
+#ifndef CHROMARESAMPLING_H_
+#define CHROMARESAMPLING_H_
+
+namespace imageshrink
+{
+
+// line kernels for the conversion between 4:4:4 and 4:2:0 chroma planes
+struct ChromaResamplingImplementation
+{
+    const char * name;
+
+    // out[x] = ( line0[2x] + line0[2x+1] + line1[2x] + line1[2x+1] ) / 4
+    void (*downsample2x2)( const unsigned char * line0, const unsigned char * line1, unsigned char * out, int nofOutPixels );
+
+    // out[2x] = out[2x+1] = in[x]
+    void (*upsample2x)( const unsigned char * in, unsigned char * out, int nofInPixels );
+};
+
+// implementation chosen for this cpu (avx2, sse2 or scalar)
+const ChromaResamplingImplementation & getChromaResampling();
+
+// all implementations the cpu supports (e.g. for benchmarks)
+int getNofChromaResamplingImplementations();
+const ChromaResamplingImplementation & getChromaResamplingImplementation( int index );
+
+} //namespace imageshrink
+
+#endif //CHROMARESAMPLING_H_
@@ -0,0 +1,131 @@
+
+// include system headers
+#include <vector>
+#include <cerrno>
+#include <cstring>      // std::memcpy
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// include own headers
+#include "FileLoader.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+static ImageBufferShrdPtr mapFile( int fileDescriptor, std::size_t size )
+{
+    void * const mapping = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+
+    if( mapping == MAP_FAILED )
+    {
+        return ImageBufferShrdPtr();
+    }
+
+    // the file is parsed front to back (markers, entropy coded data)
+    madvise( mapping, size, MADV_SEQUENTIAL );
+
+    return std::make_shared<ImageBuffer>(
+        static_cast<unsigned char *>( mapping ),
+        size,
+        [size]( unsigned char * image ) { munmap( image, size ); }
+    );
+}
+
+static ImageBufferShrdPtr readFile( int fileDescriptor )
+{
+    std::vector<unsigned char> content;
+    unsigned char chunk[ 64 * 1024 ];
+
+    for( ;; )
+    {
+        const ssize_t nofBytes = read( fileDescriptor, chunk, sizeof( chunk ) );
+
+        if( nofBytes == 0 )
+        {
+            break;
+        }
+
+        if( nofBytes < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+
+            return ImageBufferShrdPtr();
+        }
+
+        content.insert( content.end(), chunk, chunk + nofBytes );
+    }
+
+    if( content.empty() )
+    {
+        return ImageBufferShrdPtr();
+    }
+
+    ImageBufferShrdPtr ret = std::make_shared<ImageBuffer>( content.size() );
+    std::memcpy( ret->image, content.data(), content.size() );
+
+    return ret;
+}
+
+ImageBufferShrdPtr loadFile( const std::string & path )
+{
+    ImageBufferShrdPtr ret;
+    const int fileDescriptor = open( path.c_str(), O_RDONLY );
+
+    if( fileDescriptor < 0 )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerImage, "file " << path << " could not be opened" );
+#endif //USE_LOG4CXX
+        return ret;
+    }
+
+    struct stat fileStat;
+
+    if(    ( fstat( fileDescriptor, &fileStat ) == 0 )
+        && ( S_ISREG( fileStat.st_mode ) )
+      )
+    {
+        if( fileStat.st_size > 0 )
+        {
+            ret = mapFile( fileDescriptor, fileStat.st_size );
+        }
+    }
+
+    // pipes and other files that cannot be mapped
+    if( !ret )
+    {
+        ret = readFile( fileDescriptor );
+    }
+
+    // the mapping stays valid without the descriptor
+    close( fileDescriptor );
+
+#ifdef USE_LOG4CXX
+    if( !ret )
+    {
+        LOG4CXX_ERROR( loggerImage, "file " << path << " could not be read" );
+    }
+#endif //USE_LOG4CXX
+
+    return ret;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,21 @@
+
+#ifndef FILELOADER_H_
+#define FILELOADER_H_
+
+// include system headers
+#include <string>
+
+// include application headers
+#include "ImageBuffer.h"
+
+namespace imageshrink
+{
+
+// content of a file; regular files are mapped read-only (the mapping lives
+// as long as the buffer), everything else (e.g. pipes) is read;
+// nullptr on failure
+ImageBufferShrdPtr loadFile( const std::string & path );
+
+} //namespace imageshrink
+
+#endif //FILELOADER_H_
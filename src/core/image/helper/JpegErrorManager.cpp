@@ -0,0 +1,36 @@
+
+// include system headers
+// ...
+
+// include own headers
+#include "JpegErrorManager.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+void jpegErrorExit( j_common_ptr cinfo )
+{
+    JpegErrorManager * const errorManager = reinterpret_cast<JpegErrorManager *>( cinfo->err );
+
+#ifdef USE_LOG4CXX
+    char message[ JMSG_LENGTH_MAX ];
+    ( *cinfo->err->format_message )( cinfo, message );
+    LOG4CXX_ERROR( loggerImage, "libjpeg: " << message );
+#endif //USE_LOG4CXX
+
+    std::longjmp( errorManager->setjmpBuffer, 1 );
+}
+
+} //namespace imageshrink
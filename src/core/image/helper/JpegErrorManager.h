@@ -0,0 +1,27 @@
+
+#ifndef JPEGERRORMANAGER_H_
+#define JPEGERRORMANAGER_H_
+
+// include system headers
+#include <cstdio>       // required by jpeglib.h
+#include <csetjmp>      // std::jmp_buf
+
+// include 3rd party headers
+#include <jpeglib.h>
+
+namespace imageshrink
+{
+
+// libjpeg terminates the process on errors by default; jump back instead
+struct JpegErrorManager
+{
+    struct jpeg_error_mgr pub;
+    std::jmp_buf          setjmpBuffer;
+};
+
+// logs the message of libjpeg and jumps back to setjmpBuffer
+void jpegErrorExit( j_common_ptr cinfo );
+
+} //namespace imageshrink
+
+#endif //JPEGERRORMANAGER_H_
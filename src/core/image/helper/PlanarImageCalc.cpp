@@ -81,5 +81,14 @@ int linePadding( int width, int padding )
     }
 }
 
+void calcChromaSubsamplingFactors( ChrominanceSubsampling::VALUE cs, int & factorX, int & factorY )
+{
+    // a MCU consists of 8x8 blocks of the chroma planes
+    const int subsamp = convert2Tj( cs );
+
+    factorX = tjMCUWidth[ subsamp ] / 8;
+    factorY = tjMCUHeight[ subsamp ] / 8;
+}
+
 } //namespace imageshrink
 
@@ -35,6 +35,9 @@ PlanarImageDesc calcPlanaerImageDescForYUV( int width, int height, ChrominanceSu
 int convert2Tj( ChrominanceSubsampling::VALUE cs );
 int linePadding( int width, int padding );
 
+// image pixels per chroma pixel in each direction
+void calcChromaSubsamplingFactors( ChrominanceSubsampling::VALUE cs, int & factorX, int & factorY );
+
 } //namespace imageshrink
 
 #endif //PLANAERIMAGECALC_H_
@@ -0,0 +1,96 @@
+
+// include own headers
+#include "TurboJpegContext.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerImage( log4cxx::Logger::getLogger( "image" ) );
+#endif //USE_LOG4CXX
+
+TurboJpegContext::TurboJpegContext()
+: m_compressor( nullptr )
+, m_decompressor( nullptr )
+, m_destination()
+, m_destinationCapacity( 0 )
+{
+    // nothing
+}
+
+TurboJpegContext::~TurboJpegContext()
+{
+    if( m_compressor != nullptr )
+    {
+        tjDestroy( m_compressor );
+    }
+
+    if( m_decompressor != nullptr )
+    {
+        tjDestroy( m_decompressor );
+    }
+}
+
+TurboJpegContext & TurboJpegContext::getThreadContext()
+{
+    thread_local TurboJpegContext context;
+    return context;
+}
+
+tjhandle TurboJpegContext::getCompressor()
+{
+    if( m_compressor == nullptr )
+    {
+        m_compressor = tjInitCompress();
+
+#ifdef USE_LOG4CXX
+        if( m_compressor == nullptr )
+        {
+            LOG4CXX_ERROR( loggerImage, "tjInitCompress(): " << tjGetErrorStr() );
+        }
+#endif //USE_LOG4CXX
+    }
+
+    return m_compressor;
+}
+
+tjhandle TurboJpegContext::getDecompressor()
+{
+    if( m_decompressor == nullptr )
+    {
+        m_decompressor = tjInitDecompress();
+
+#ifdef USE_LOG4CXX
+        if( m_decompressor == nullptr )
+        {
+            LOG4CXX_ERROR( loggerImage, "tjInitDecompress(): " << tjGetErrorStr() );
+        }
+#endif //USE_LOG4CXX
+    }
+
+    return m_decompressor;
+}
+
+ImageBufferShrdPtr TurboJpegContext::getDestinationBuffer( unsigned long minimumSize )
+{
+    // a buffer still held by a caller is left to the caller
+    if(    ( !m_destination )
+        || ( m_destination.use_count() != 1 )
+        || ( m_destinationCapacity < minimumSize )
+      )
+    {
+        m_destination         = std::make_shared<ImageBuffer>( minimumSize );
+        m_destinationCapacity = minimumSize;
+    }
+
+    m_destination->size = m_destinationCapacity;
+
+    return m_destination;
+}
+
+} //namespace imageshrink
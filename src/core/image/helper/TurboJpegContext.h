@@ -0,0 +1,68 @@
+
+#ifndef TURBOJPEGCONTEXT_H_
+#define TURBOJPEGCONTEXT_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "ImageBuffer.h"
+
+// include 3rd party headers
+#include <turbojpeg.h>
+
+namespace imageshrink
+{
+
+// declaration
+// TurboJPEG handles and the destination buffer for compressed images of
+// one thread; they are kept alive between the calls of the thread
+class TurboJpegContext
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        virtual ~TurboJpegContext();
+
+    protected:
+
+    private:
+        TurboJpegContext();
+        TurboJpegContext( const TurboJpegContext & );               // not copyable
+        TurboJpegContext & operator=( const TurboJpegContext & );   // not copyable
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        tjhandle           m_compressor;
+        tjhandle           m_decompressor;
+        ImageBufferShrdPtr m_destination;
+        unsigned long      m_destinationCapacity;
+
+    //********** METHODS **********
+    public:
+        // context of the calling thread
+        static TurboJpegContext & getThreadContext();
+
+        // handles are created on first use; nullptr on failure
+        tjhandle getCompressor();
+        tjhandle getDecompressor();
+
+        // buffer with at least minimumSize bytes (for TJFLAG_NOREALLOC);
+        // the buffer is reused as soon as nobody else holds it any more
+        ImageBufferShrdPtr getDestinationBuffer( unsigned long minimumSize );
+
+    protected:
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //TURBOJPEGCONTEXT_H_
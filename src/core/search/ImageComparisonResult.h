@@ -0,0 +1,44 @@
+
+#ifndef IMAGECOMPARISONRESULT_H_
+#define IMAGECOMPARISONRESULT_H_
+
+// include system headers
+// ...
+
+// include application headers
+// ...
+
+namespace imageshrink
+{
+
+// declaration
+// dssimAvg and dssimPeak are the weighted means over the compared planes
+struct ImageComparisonResult
+{
+    static const int maxNofPlanes = 3;
+
+    ImageComparisonResult()
+    : dssimAvg( 0.0 )
+    , dssimPeak( 0.0 )
+    , candidateSize( 0 )
+    {
+        for( int i = 0; i < maxNofPlanes; ++i )
+        {
+            dssimAvgPlanes[i]  = 0.0;
+            dssimPeakPlanes[i] = 0.0;
+        }
+    }
+
+    double dssimAvg;
+    double dssimPeak;
+
+    long long candidateSize;   // in bytes as encoded for the comparison; 0 if not encoded (DCT engine)
+
+    // per plane (Y/Cb/Cr resp. R/G/B); 0 for planes not compared
+    double dssimAvgPlanes[ maxNofPlanes ];
+    double dssimPeakPlanes[ maxNofPlanes ];
+};
+
+} //namespace imageshrink
+
+#endif //IMAGECOMPARISONRESULT_H_
@@ -0,0 +1,407 @@
+
+// include system headers
+#include <algorithm>    // std::find
+#include <limits>
+
+// include own headers
+#include "QualityEvaluator.h"
+
+// include application headers
+#include "ImageStatistics.h"
+#include "ImageDSSIM.h"
+#include "StatsRecord.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerSearch( log4cxx::Logger::getLogger( "search" ) );
+#endif //USE_LOG4CXX
+
+QualityEvaluator::QualityEvaluator( const ImageJfif & original,
+                                    ChrominanceSubsampling::VALUE cs,
+                                    int averaging,
+                                    ComparisonEngine::VALUE engine,
+                                    int peakStride,
+                                    SimilarityMetric::VALUE metric )
+: m_original( original )
+, m_chrominanceSubsampling( cs )
+, m_averaging( averaging )
+, m_reference()
+, m_planeReferences()
+, m_planeWeights()
+, m_slidingWindowDSSIM()
+, m_gaussianSSIM()
+, m_multiScaleSSIM()
+, m_coefficientDSSIM()
+, m_stripDSSIM()
+, m_results()
+, m_nofEvaluations( 0 )
+, m_dssimAvgMax( std::numeric_limits<double>::max() )
+, m_dssimPeakMax( std::numeric_limits<double>::max() )
+, m_statisticsPrecision( StatisticsPrecision::BITS_8 )
+{
+    if( engine == ComparisonEngine::DCT )
+    {
+        ImageJfifCoefficientsShrdPtr coefficients = std::make_shared<ImageJfifCoefficients>( m_original.getCompressedImageBuffer() );
+        m_coefficientDSSIM = std::make_shared<CoefficientDSSIM>( coefficients, m_averaging );
+
+        if( m_coefficientDSSIM->isValid() )
+        {
+            return;
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_WARN( loggerSearch, "DCT engine not applicable; fall back to the pixel engine" );
+#endif //USE_LOG4CXX
+        m_coefficientDSSIM.reset();
+    }
+
+    if( engine == ComparisonEngine::STRIPS )
+    {
+        m_stripDSSIM = std::make_shared<StripDSSIM>( m_original, m_chrominanceSubsampling, m_averaging );
+
+        if( m_stripDSSIM->isValid() )
+        {
+            return;
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_WARN( loggerSearch, "strip engine not applicable; fall back to the pixel engine" );
+#endif //USE_LOG4CXX
+        m_stripDSSIM.reset();
+    }
+
+    // the pixel engine needs the decompressed original
+    if( !m_original.decompressImage() )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerSearch, "original could not be decompressed" );
+#endif //USE_LOG4CXX
+    }
+
+    if( metric == SimilarityMetric::MSSSIM )
+    {
+        m_multiScaleSSIM = std::make_shared<MultiScaleSSIM>( m_original, m_averaging );
+
+        if( m_multiScaleSSIM->isValid() )
+        {
+            return;
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_WARN( loggerSearch, "MS-SSIM not applicable; fall back to the block metric" );
+#endif //USE_LOG4CXX
+        m_multiScaleSSIM.reset();
+    }
+
+    // the original is the same for all candidates; so everything about it
+    // is determined only once
+    m_reference = std::make_shared<ImageReferenceContext>( m_original, m_averaging );
+
+    if( metric == SimilarityMetric::GAUSSIAN )
+    {
+        m_gaussianSSIM = std::make_shared<GaussianSSIM>( m_reference );
+
+        if( m_gaussianSSIM->isValid() )
+        {
+            return;
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_WARN( loggerSearch, "Gaussian SSIM not applicable; fall back to the block metric" );
+#endif //USE_LOG4CXX
+        m_gaussianSSIM.reset();
+    }
+
+    if( peakStride > 0 )
+    {
+        m_slidingWindowDSSIM = std::make_shared<SlidingWindowDSSIM>( m_reference, peakStride );
+
+        if( !m_slidingWindowDSSIM->isValid() )
+        {
+#ifdef USE_LOG4CXX
+            LOG4CXX_WARN( loggerSearch, "sliding window DSSIM not applicable; the peak is taken over the chunks" );
+#endif //USE_LOG4CXX
+            m_slidingWindowDSSIM.reset();
+        }
+    }
+}
+
+bool QualityEvaluator::isEvaluated( int quality ) const
+{
+    return ( m_results.find( quality ) != m_results.end() );
+}
+
+void QualityEvaluator::setRejectionLimits( double dssimAvgMax, double dssimPeakMax )
+{
+    m_dssimAvgMax  = dssimAvgMax;
+    m_dssimPeakMax = dssimPeakMax;
+}
+
+void QualityEvaluator::setPlaneWeights( double weightY, double weightCb, double weightCr )
+{
+    m_planeReferences.clear();
+    m_planeWeights.clear();
+
+    // the other metrics and the DCT engine compare the luminance only
+    if(    ( !m_reference )
+        || ( m_gaussianSSIM )
+        || ( m_multiScaleSSIM )
+        || ( ( weightCb <= 0.0 ) && ( weightCr <= 0.0 ) )
+      )
+    {
+        return;
+    }
+
+    const double weights[ ImageComparisonResult::maxNofPlanes ] = { weightY, weightCb, weightCr };
+
+    for( int plane = 0; plane < ImageComparisonResult::maxNofPlanes; ++plane )
+    {
+        if( weights[ plane ] <= 0.0 )
+        {
+            continue;
+        }
+
+        ImageReferenceContextShrdPtr reference = ( plane == 0 ) ? m_reference : std::make_shared<ImageReferenceContext>( m_original, m_averaging, plane );
+
+        if( !reference->isValid() )
+        {
+#ifdef USE_LOG4CXX
+            LOG4CXX_WARN( loggerSearch, "plane " << plane << " not applicable; only the luminance is compared" );
+#endif //USE_LOG4CXX
+            m_planeReferences.clear();
+            m_planeWeights.clear();
+            return;
+        }
+
+        m_planeReferences.push_back( reference );
+        m_planeWeights.push_back( weights[ plane ] );
+    }
+}
+
+ImageComparisonResult QualityEvaluator::evaluate( int quality )
+{
+    const auto resultEntry = m_results.find( quality );
+
+    if( resultEntry != m_results.end() )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_WARN( loggerSearch,
+                     "DSSIM = "
+                     << resultEntry->second.dssimAvg
+                     << "; DSSIM Peak = "
+                     << resultEntry->second.dssimPeak
+                     << "; quality = " << quality
+                     << " (restored result)"
+        );
+#endif //USE_LOG4CXX
+
+        return resultEntry->second;
+    }
+
+    evaluate( std::vector<int>( 1, quality ) );
+    return m_results[ quality ];
+}
+
+void QualityEvaluator::evaluate( const std::vector<int> & qualities )
+{
+    // collect the qualities which are not known yet
+    std::vector<int> pending;
+
+    for( auto it = qualities.begin(); it != qualities.end(); ++it )
+    {
+        if(    ( !isEvaluated( *it ) )
+            && ( std::find( pending.begin(), pending.end(), *it ) == pending.end() )
+          )
+        {
+            pending.push_back( *it );
+        }
+    }
+
+    const int nofPending = pending.size();
+    std::vector<ImageComparisonResult> results( nofPending );
+
+    // the workers measure for the record of the calling thread
+    StatsRecord * const record = StatsRecord::getCurrent();
+
+    // a single candidate keeps the parallelism of the transformations;
+    // several candidates are distributed over the threads instead
+    #pragma omp parallel for schedule(dynamic, 1) if( nofPending > 1 )
+    for( int i = 0; i < nofPending; ++i )
+    {
+        StatsScope scope( record );
+        results[i] = compare( pending[i] );
+    }
+
+    if(    ( record != nullptr )
+        && ( nofPending > 0 )
+      )
+    {
+        record->addRound();
+    }
+
+    for( int i = 0; i < nofPending; ++i )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_WARN( loggerSearch,
+                     "DSSIM = "
+                     << results[i].dssimAvg
+                     << "; DSSIM Peak = "
+                     << results[i].dssimPeak
+                     << "; quality = " << pending[i]
+        );
+
+        if( !m_planeReferences.empty() )
+        {
+            LOG4CXX_INFO( loggerSearch,
+                         "DSSIM per plane = "
+                         << results[i].dssimAvgPlanes[0] << " / "
+                         << results[i].dssimAvgPlanes[1] << " / "
+                         << results[i].dssimAvgPlanes[2]
+                         << "; DSSIM Peak per plane = "
+                         << results[i].dssimPeakPlanes[0] << " / "
+                         << results[i].dssimPeakPlanes[1] << " / "
+                         << results[i].dssimPeakPlanes[2]
+            );
+        }
+#endif //USE_LOG4CXX
+
+        if( record != nullptr )
+        {
+            record->addCandidate( pending[i], results[i].candidateSize, results[i].dssimAvg, results[i].dssimPeak );
+        }
+
+        m_results[ pending[i] ] = results[i];
+        m_nofEvaluations++;
+    }
+}
+
+ImageComparisonResult QualityEvaluator::compare( int quality )
+{
+    ImageComparisonResult ret;
+
+    if( m_coefficientDSSIM )
+    {
+        return compareCoefficients( quality );
+    }
+
+    if( m_stripDSSIM )
+    {
+        return compareStrips( quality );
+    }
+
+    // the candidate stays at its native subsampling; only the luminance
+    // is compared and its plane does not depend on the subsampling
+    ImageJfif candidate = m_original.getCompressedDecompressedImage( quality, m_chrominanceSubsampling, ret.candidateSize );
+
+    if( m_multiScaleSSIM )
+    {
+        m_multiScaleSSIM->compare( candidate, m_dssimAvgMax, m_dssimPeakMax, ret.dssimAvg, ret.dssimPeak );
+        return ret;
+    }
+
+    if( m_gaussianSSIM )
+    {
+        m_gaussianSSIM->compare( candidate, ret.dssimAvg, ret.dssimPeak );
+        return ret;
+    }
+
+    if( !m_planeReferences.empty() )
+    {
+        const long long candidateSize = ret.candidateSize;
+
+        ret = comparePlanes( candidate );
+        ret.candidateSize = candidateSize;
+
+        return ret;
+    }
+
+    // one pass over the candidate delivers everything else the DSSIM needs
+    ImageStatistics statistics( *m_reference, candidate );
+    ImageDSSIM imageDSSIM( statistics, m_statisticsPrecision );
+
+    ret.dssimAvg  = imageDSSIM.getDssim();
+    ret.dssimPeak = imageDSSIM.getDssimPeak();
+
+    if( m_slidingWindowDSSIM )
+    {
+        m_slidingWindowDSSIM->calcPeak( candidate, ret.dssimPeak, m_statisticsPrecision );
+    }
+
+    ret.dssimAvgPlanes[0]  = ret.dssimAvg;
+    ret.dssimPeakPlanes[0] = ret.dssimPeak;
+
+    return ret;
+}
+
+ImageComparisonResult QualityEvaluator::comparePlanes( const ImageJfif & candidate )
+{
+    ImageComparisonResult ret;
+
+    // the planes share one pass over the chunk lines
+    std::vector<ImageStatistics> statistics = ImageStatistics::calcPlaneStatistics( m_planeReferences, candidate );
+
+    if( statistics.size() != m_planeReferences.size() )
+    {
+        return ret;
+    }
+
+    double weightSum = 0.0;
+
+    for( std::size_t i = 0; i < statistics.size(); ++i )
+    {
+        const int plane = m_planeReferences[i]->getPlaneIndex();
+        ImageDSSIM imageDSSIM( statistics[i], m_statisticsPrecision );
+
+        ret.dssimAvgPlanes[ plane ]  = imageDSSIM.getDssim();
+        ret.dssimPeakPlanes[ plane ] = imageDSSIM.getDssimPeak();
+
+        if(    ( plane == 0 )
+            && ( m_slidingWindowDSSIM )
+          )
+        {
+            m_slidingWindowDSSIM->calcPeak( candidate, ret.dssimPeakPlanes[0], m_statisticsPrecision );
+        }
+
+        ret.dssimAvg  += m_planeWeights[i] * ret.dssimAvgPlanes[ plane ];
+        ret.dssimPeak += m_planeWeights[i] * ret.dssimPeakPlanes[ plane ];
+        weightSum     += m_planeWeights[i];
+    }
+
+    ret.dssimAvg  /= weightSum;
+    ret.dssimPeak /= weightSum;
+
+    return ret;
+}
+
+ImageComparisonResult QualityEvaluator::compareCoefficients( int quality )
+{
+    ImageComparisonResult ret;
+
+    // the luminance does not depend on the chrominance subsampling;
+    // so the requantized coefficients are compared directly
+    m_coefficientDSSIM->compare( quality, ret.dssimAvg, ret.dssimPeak );
+
+    return ret;
+}
+
+ImageComparisonResult QualityEvaluator::compareStrips( int quality )
+{
+    ImageComparisonResult ret;
+
+    // the luminance only; the candidate is never decoded completely
+    m_stripDSSIM->compare( quality, m_statisticsPrecision, ret.dssimAvg, ret.dssimPeak, ret.candidateSize );
+
+    ret.dssimAvgPlanes[0]  = ret.dssimAvg;
+    ret.dssimPeakPlanes[0] = ret.dssimPeak;
+
+    return ret;
+}
+
+} //namespace imageshrink
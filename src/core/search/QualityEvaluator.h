@@ -0,0 +1,116 @@
+
+#ifndef QUALITYEVALUATOR_H_
+#define QUALITYEVALUATOR_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <unordered_map>
+#include <vector>
+
+// include application headers
+#include "ImageJfif.h"
+#include "ImageComparisonResult.h"
+#include "CoefficientDSSIM.h"
+#include "StripDSSIM.h"
+#include "ImageReferenceContext.h"
+#include "SlidingWindowDSSIM.h"
+#include "GaussianSSIM.h"
+#include "MultiScaleSSIM.h"
+#include "enumComparisonEngine.h"
+#include "enumSimilarityMetric.h"
+#include "enumStatisticsPrecision.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class QualityEvaluator;
+typedef std::shared_ptr<QualityEvaluator> QualityEvaluatorShrdPtr;
+typedef std::weak_ptr<QualityEvaluator>   QualityEvaluatorWkPtr;
+
+// declaration
+class QualityEvaluator
+: public std::enable_shared_from_this<QualityEvaluator>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    private:
+        typedef std::unordered_map<int /*quality*/, ImageComparisonResult> QualityResultMap;
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        // peakStride > 0: the peak DSSIM is taken over sliding windows (pixel engine, block metric only);
+        // the original may be loaded without decompression for the DCT and the strip engine
+        QualityEvaluator( const ImageJfif & original,
+                          ChrominanceSubsampling::VALUE cs,
+                          int averaging,
+                          ComparisonEngine::VALUE engine = ComparisonEngine::PIXEL,
+                          int peakStride = 0,
+                          SimilarityMetric::VALUE metric = SimilarityMetric::BLOCK );
+        virtual ~QualityEvaluator() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        ImageJfif                     m_original;
+        ChrominanceSubsampling::VALUE m_chrominanceSubsampling;
+        int                           m_averaging;
+
+        ImageReferenceContextShrdPtr  m_reference;          // pixel engine
+        std::vector<ImageReferenceContextShrdPtr> m_planeReferences;   // block metric with chroma, m_reference first
+        std::vector<double>                       m_planeWeights;
+        SlidingWindowDSSIMShrdPtr     m_slidingWindowDSSIM; // pixel engine, optional
+        GaussianSSIMShrdPtr           m_gaussianSSIM;       // pixel engine, optional
+        MultiScaleSSIMShrdPtr         m_multiScaleSSIM;     // pixel engine, optional
+        CoefficientDSSIMShrdPtr       m_coefficientDSSIM;   // DCT engine
+        StripDSSIMShrdPtr             m_stripDSSIM;         // strip engine
+        QualityResultMap              m_results;
+        int                           m_nofEvaluations;
+        double                        m_dssimAvgMax;        // limits for an early rejection
+        double                        m_dssimPeakMax;
+        StatisticsPrecision::VALUE    m_statisticsPrecision;    // block metric
+
+    //********** METHODS **********
+    public:
+        // returns the (cached) comparison result for one quality
+        ImageComparisonResult evaluate( int quality );
+
+        // evaluates all not yet known qualities concurrently
+        void evaluate( const std::vector<int> & qualities );
+
+        bool isEvaluated( int quality ) const;
+
+        // metrics which can reject a candidate before they are finished (MS-SSIM)
+        // stop as soon as one of the limits is reached
+        void setRejectionLimits( double dssimAvgMax, double dssimPeakMax );
+
+        // weights of the planes in the DSSIM of the block metric; planes with
+        // a weight of 0 are not compared (default: the luminance only);
+        // has to be called before the first evaluation
+        void setPlaneWeights( double weightY, double weightCb, double weightCr );
+
+        // precision of the chunk statistics in the block metric
+        void setStatisticsPrecision( StatisticsPrecision::VALUE precision ) { m_statisticsPrecision = precision; }
+        int getNofEvaluations() const { return m_nofEvaluations; }
+
+    protected:
+
+    private:
+        ImageComparisonResult compare( int quality );
+        ImageComparisonResult compareCoefficients( int quality );
+        ImageComparisonResult compareStrips( int quality );
+        ImageComparisonResult comparePlanes( const ImageJfif & candidate );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //QUALITYEVALUATOR_H_
@@ -0,0 +1,83 @@
+
+// include system headers
+#include <algorithm>    // std::max
+#include <cmath>        // std::log
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif //_OPENMP
+
+// include own headers
+#include "QualitySearchBase.h"
+
+// include application headers
+#include "QualitySearchLinear.h"
+#include "QualitySearchBisection.h"
+#include "QualitySearchSecant.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerSearch( log4cxx::Logger::getLogger( "search" ) );
+#endif //USE_LOG4CXX
+
+QualitySearchBase::QualitySearchBase( const Settings & settings )
+: m_qualityMin( settings.qualityMin )
+, m_qualityMax( settings.qualityMax )
+, m_initQualityStep( settings.initQualityStep )
+, m_dssimAvgMax( settings.dssimAvgMax )
+, m_dssimPeakMax( settings.dssimPeakMax )
+, m_parallelQualities( settings.parallelQualities )
+{
+    if( m_parallelQualities <= 0 )
+    {
+#ifdef _OPENMP
+        m_parallelQualities = omp_get_max_threads();
+#else
+        m_parallelQualities = 1;
+#endif //_OPENMP
+    }
+}
+
+QualitySearchBaseShrdPtr QualitySearchBase::create( const Settings & settings )
+{
+    QualitySearchBaseShrdPtr ret;
+
+    switch( settings.qualitySearch )
+    {
+        case QualitySearch::LINEAR:    ret = std::make_shared<QualitySearchLinear>( settings ); break;
+        case QualitySearch::BISECTION: ret = std::make_shared<QualitySearchBisection>( settings ); break;
+        case QualitySearch::SECANT:    ret = std::make_shared<QualitySearchSecant>( settings ); break;
+        default:
+#ifdef USE_LOG4CXX
+            LOG4CXX_ERROR( loggerSearch, "quality search not supported: " << QualitySearch::toString( settings.qualitySearch ) );
+#endif //USE_LOG4CXX
+            break;
+    }
+
+    return ret;
+}
+
+bool QualitySearchBase::isAccepted( const ImageComparisonResult & icr ) const
+{
+    return (    ( icr.dssimAvg < m_dssimAvgMax )
+             && ( icr.dssimPeak < m_dssimPeakMax )
+           );
+}
+
+double QualitySearchBase::getDeviation( const ImageComparisonResult & icr ) const
+{
+    const double epsilon = 1e-12;
+    const double ratioAvg  = icr.dssimAvg  / std::max( m_dssimAvgMax,  epsilon );
+    const double ratioPeak = icr.dssimPeak / std::max( m_dssimPeakMax, epsilon );
+
+    return std::log( std::max( std::max( ratioAvg, ratioPeak ), 1e-6 ) );
+}
+
+} //namespace imageshrink
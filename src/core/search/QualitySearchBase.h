@@ -0,0 +1,69 @@
+
+#ifndef QUALITYSEARCHBASE_H_
+#define QUALITYSEARCHBASE_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "QualityEvaluator.h"
+#include "settings.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class QualitySearchBase;
+typedef std::shared_ptr<QualitySearchBase> QualitySearchBaseShrdPtr;
+typedef std::weak_ptr<QualitySearchBase>   QualitySearchBaseWkPtr;
+
+// declaration
+class QualitySearchBase
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        virtual ~QualitySearchBase() {}
+
+    protected:
+        QualitySearchBase( const Settings & settings );
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+        int    m_qualityMin;
+        int    m_qualityMax;
+        int    m_initQualityStep;
+        double m_dssimAvgMax;
+        double m_dssimPeakMax;
+        int    m_parallelQualities;
+
+    private:
+
+    //********** METHODS **********
+    public:
+        // returns the lowest quality which fulfills the DSSIM limits
+        virtual int findQuality( QualityEvaluator & evaluator ) = 0;
+
+        // creates the search strategy selected in the settings
+        static QualitySearchBaseShrdPtr create( const Settings & settings );
+
+    protected:
+        bool isAccepted( const ImageComparisonResult & icr ) const;
+
+        // log of the largest ratio between DSSIM and its limit;
+        // < 0 for accepted qualities, decreasing with the quality
+        double getDeviation( const ImageComparisonResult & icr ) const;
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //QUALITYSEARCHBASE_H_
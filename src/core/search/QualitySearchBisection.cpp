@@ -0,0 +1,90 @@
+
+// include system headers
+#include <algorithm>    // std::min
+#include <vector>
+
+// include own headers
+#include "QualitySearchBisection.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerSearch( log4cxx::Logger::getLogger( "search" ) );
+#endif //USE_LOG4CXX
+
+QualitySearchBisection::QualitySearchBisection( const Settings & settings )
+: QualitySearchBase( settings )
+{
+}
+
+int QualitySearchBisection::findQuality( QualityEvaluator & evaluator )
+{
+    // invariant: qualityLow is rejected (or the lower limit), qualityHigh is accepted
+    int qualityLow  = m_qualityMin;
+    int qualityHigh = m_qualityMax;
+
+    if( !isAccepted( evaluator.evaluate( qualityHigh ) ) )
+    {
+        // like the linear search, continue above the maximum quality
+        qualityLow  = m_qualityMax;
+        qualityHigh = 100;
+
+        if(    ( qualityHigh == qualityLow )
+            || ( !isAccepted( evaluator.evaluate( qualityHigh ) ) )
+          )
+        {
+            return qualityHigh;
+        }
+    }
+
+    while( ( qualityHigh - qualityLow ) > 1 )
+    {
+        // split the interval into ( nofCandidates + 1 ) parts;
+        // one candidate is a plain bisection
+        const int range = qualityHigh - qualityLow;
+        const int nofCandidates = std::min( m_parallelQualities, range - 1 );
+        std::vector<int> candidates;
+
+        for( int i = 1; i <= nofCandidates; ++i )
+        {
+            const int quality = qualityLow + ( range * i ) / ( nofCandidates + 1 );
+
+            if(    ( candidates.empty() )
+                || ( candidates.back() != quality )
+              )
+            {
+                candidates.push_back( quality );
+            }
+        }
+
+        evaluator.evaluate( candidates );
+
+        for( auto it = candidates.begin(); it != candidates.end(); ++it )
+        {
+            if( isAccepted( evaluator.evaluate( *it ) ) )
+            {
+                qualityHigh = *it;
+                break;
+            }
+
+            qualityLow = *it;
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_INFO( loggerSearch, "quality interval = (" << qualityLow << ", " << qualityHigh << "]" );
+#endif //USE_LOG4CXX
+    }
+
+    return qualityHigh;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,56 @@
+
+#ifndef QUALITYSEARCHBISECTION_H_
+#define QUALITYSEARCHBISECTION_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "QualitySearchBase.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class QualitySearchBisection;
+typedef std::shared_ptr<QualitySearchBisection> QualitySearchBisectionShrdPtr;
+typedef std::weak_ptr<QualitySearchBisection>   QualitySearchBisectionWkPtr;
+
+// declaration
+class QualitySearchBisection
+: public std::enable_shared_from_this<QualitySearchBisection>
+, public QualitySearchBase
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        QualitySearchBisection( const Settings & settings );
+        virtual ~QualitySearchBisection() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+
+    //********** METHODS **********
+    public:
+        // implement QualitySearchBase
+        virtual int findQuality( QualityEvaluator & evaluator );
+
+    protected:
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //QUALITYSEARCHBISECTION_H_
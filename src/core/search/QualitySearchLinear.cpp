@@ -0,0 +1,92 @@
+
+// include system headers
+#include <vector>
+
+// include own headers
+#include "QualitySearchLinear.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerSearch( log4cxx::Logger::getLogger( "search" ) );
+#endif //USE_LOG4CXX
+
+QualitySearchLinear::QualitySearchLinear( const Settings & settings )
+: QualitySearchBase( settings )
+{
+}
+
+void QualitySearchLinear::evaluateSpeculatively( QualityEvaluator & evaluator, int quality, int qualityStep )
+{
+    std::vector<int> candidates;
+
+    while(    ( quality > m_qualityMin )
+           && ( static_cast<int>( candidates.size() ) < m_parallelQualities )
+         )
+    {
+        if( evaluator.isEvaluated( quality ) )
+        {
+            // a known rejected quality terminates the descent anyway
+            if( !isAccepted( evaluator.evaluate( quality ) ) )
+            {
+                break;
+            }
+        }
+        else
+        {
+            candidates.push_back( quality );
+        }
+
+        quality -= qualityStep;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_DEBUG( loggerSearch, "evaluate " << candidates.size() << " qualities speculatively" );
+#endif //USE_LOG4CXX
+
+    evaluator.evaluate( candidates );
+}
+
+int QualitySearchLinear::findQuality( QualityEvaluator & evaluator )
+{
+    int quality = m_qualityMax;
+    int qualityStep = m_initQualityStep;
+
+    while( qualityStep != 0 )
+    {
+        ImageComparisonResult icr;
+
+        while(    isAccepted( icr )
+               && ( quality > m_qualityMin )
+             )
+        {
+            if( !evaluator.isEvaluated( quality ) )
+            {
+                evaluateSpeculatively( evaluator, quality, qualityStep );
+            }
+
+            icr = evaluator.evaluate( quality );
+            quality -= qualityStep;
+        }
+
+        quality     += ( 2 * qualityStep );
+        qualityStep /= 2;   // qualityStep == 0: end of loop
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_INFO( loggerSearch, "qualityStep = " << qualityStep );
+#endif //USE_LOG4CXX
+    }
+
+    return quality;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,58 @@
+
+#ifndef QUALITYSEARCHLINEAR_H_
+#define QUALITYSEARCHLINEAR_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "QualitySearchBase.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class QualitySearchLinear;
+typedef std::shared_ptr<QualitySearchLinear> QualitySearchLinearShrdPtr;
+typedef std::weak_ptr<QualitySearchLinear>   QualitySearchLinearWkPtr;
+
+// declaration
+class QualitySearchLinear
+: public std::enable_shared_from_this<QualitySearchLinear>
+, public QualitySearchBase
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        QualitySearchLinear( const Settings & settings );
+        virtual ~QualitySearchLinear() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+
+    //********** METHODS **********
+    public:
+        // implement QualitySearchBase
+        virtual int findQuality( QualityEvaluator & evaluator );
+
+    protected:
+
+    private:
+        // evaluates the qualities the descending loop would visit next
+        void evaluateSpeculatively( QualityEvaluator & evaluator, int quality, int qualityStep );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //QUALITYSEARCHLINEAR_H_
@@ -0,0 +1,166 @@
+
+// include system headers
+#include <algorithm>    // std::min, std::max
+#include <cmath>        // std::ceil
+#include <vector>
+
+// include own headers
+#include "QualitySearchSecant.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerSearch( log4cxx::Logger::getLogger( "search" ) );
+#endif //USE_LOG4CXX
+
+QualitySearchSecant::QualitySearchSecant( const Settings & settings )
+: QualitySearchBase( settings )
+{
+}
+
+int QualitySearchSecant::interpolate( int qualityLow, double deviationLow, int qualityHigh, double deviationHigh )
+{
+    if( deviationLow == deviationHigh )
+    {
+        return ( qualityLow + qualityHigh ) / 2;
+    }
+
+    const double root = qualityHigh - deviationHigh * ( qualityHigh - qualityLow ) / ( deviationHigh - deviationLow );
+
+    return static_cast<int>( std::ceil( std::max( std::min( root, 1000.0 ), -1000.0 ) ) );
+}
+
+int QualitySearchSecant::findQuality( QualityEvaluator & evaluator )
+{
+    // invariant: qualityLow is rejected (or the lower limit), qualityHigh is accepted
+    int    qualityLow       = m_qualityMin;
+    double deviationLow     = 0.0;
+    bool   lowEvaluated     = false;
+
+    int    qualityHigh      = m_qualityMax;
+    double deviationHigh    = 0.0;
+
+    // accepted quality evaluated before qualityHigh; used to extrapolate
+    // as long as no rejected quality is known
+    int    qualityPrevious   = 0;
+    double deviationPrevious = 0.0;
+    bool   previousEvaluated = false;
+
+    // last moved bound (-1: low, +1: high); used by the Illinois modification
+    int    lastMoved        = 0;
+
+    const ImageComparisonResult icrMax = evaluator.evaluate( qualityHigh );
+    deviationHigh = getDeviation( icrMax );
+
+    if( !isAccepted( icrMax ) )
+    {
+        // like the linear search, continue above the maximum quality
+        qualityLow   = m_qualityMax;
+        deviationLow = deviationHigh;
+        lowEvaluated = true;
+        qualityHigh  = 100;
+
+        if( qualityHigh == qualityLow )
+        {
+            return qualityHigh;
+        }
+
+        const ImageComparisonResult icr100 = evaluator.evaluate( qualityHigh );
+
+        if( !isAccepted( icr100 ) )
+        {
+            return qualityHigh;
+        }
+
+        deviationHigh = getDeviation( icr100 );
+    }
+
+    while( ( qualityHigh - qualityLow ) > 1 )
+    {
+        int quality = 0;
+
+        if( lowEvaluated )
+        {
+            // regula falsi within the bracket
+            quality = interpolate( qualityLow, deviationLow, qualityHigh, deviationHigh );
+        }
+        else if( previousEvaluated )
+        {
+            // extrapolate the two accepted qualities
+            quality = interpolate( qualityHigh, deviationHigh, qualityPrevious, deviationPrevious );
+
+            if( quality >= qualityHigh )
+            {
+                quality = qualityHigh - m_initQualityStep;
+            }
+        }
+        else
+        {
+            quality = qualityHigh - m_initQualityStep;
+        }
+
+        quality = std::max( std::min( quality, qualityHigh - 1 ), qualityLow + 1 );
+
+        // the accepted side of the estimated root is checked together with the
+        // rejected side, so an exact estimate terminates with one batch
+        std::vector<int> candidates;
+        if(    ( m_parallelQualities > 1 )
+            && ( ( quality - 1 ) > qualityLow )
+          )
+        {
+            candidates.push_back( quality - 1 );
+        }
+        candidates.push_back( quality );
+
+        evaluator.evaluate( candidates );
+
+        for( auto it = candidates.begin(); it != candidates.end(); ++it )
+        {
+            const ImageComparisonResult icr = evaluator.evaluate( *it );
+
+            if( isAccepted( icr ) )
+            {
+                qualityPrevious   = qualityHigh;
+                deviationPrevious = deviationHigh;
+                previousEvaluated = true;
+
+                qualityHigh   = *it;
+                deviationHigh = getDeviation( icr );
+
+                if( lastMoved == 1 )
+                {
+                    deviationLow /= 2.0;
+                }
+                lastMoved = 1;
+                break;
+            }
+
+            qualityLow   = *it;
+            deviationLow = getDeviation( icr );
+            lowEvaluated = true;
+
+            if( lastMoved == -1 )
+            {
+                deviationHigh /= 2.0;
+            }
+            lastMoved = -1;
+        }
+
+#ifdef USE_LOG4CXX
+        LOG4CXX_INFO( loggerSearch, "quality interval = (" << qualityLow << ", " << qualityHigh << "]" );
+#endif //USE_LOG4CXX
+    }
+
+    return qualityHigh;
+}
+
+} //namespace imageshrink
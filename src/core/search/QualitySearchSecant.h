@@ -0,0 +1,58 @@
+
+#ifndef QUALITYSEARCHSECANT_H_
+#define QUALITYSEARCHSECANT_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "QualitySearchBase.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class QualitySearchSecant;
+typedef std::shared_ptr<QualitySearchSecant> QualitySearchSecantShrdPtr;
+typedef std::weak_ptr<QualitySearchSecant>   QualitySearchSecantWkPtr;
+
+// declaration
+class QualitySearchSecant
+: public std::enable_shared_from_this<QualitySearchSecant>
+, public QualitySearchBase
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        QualitySearchSecant( const Settings & settings );
+        virtual ~QualitySearchSecant() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+
+    //********** METHODS **********
+    public:
+        // implement QualitySearchBase
+        virtual int findQuality( QualityEvaluator & evaluator );
+
+    protected:
+
+    private:
+        // smallest quality in ( low, high ) the linear model of the deviation expects to be accepted
+        static int interpolate( int qualityLow, double deviationLow, int qualityHigh, double deviationHigh );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //QUALITYSEARCHSECANT_H_
@@ -0,0 +1,52 @@
+
+#ifndef SCOPEDTIMER_H_
+#define SCOPEDTIMER_H_
+
+// include system headers
+#include <chrono>
+
+// include application headers
+#include "StatsRecord.h"
+#include "enumStage.h"
+
+namespace imageshrink
+{
+
+// declaration
+// adds the lifetime of the scope to a stage of the record of the calling
+// thread; without a record the clock is not read at all
+class ScopedTimer
+{
+    public:
+        explicit ScopedTimer( Stage::VALUE stage )
+        : m_record( StatsRecord::getCurrent() )
+        , m_stage( stage )
+        , m_start()
+        {
+            if( m_record != nullptr )
+            {
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~ScopedTimer()
+        {
+            if( m_record != nullptr )
+            {
+                const std::chrono::steady_clock::duration duration = std::chrono::steady_clock::now() - m_start;
+                m_record->addTime( m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>( duration ).count() );
+            }
+        }
+
+    private:
+        ScopedTimer( const ScopedTimer & );               // not copyable
+        ScopedTimer & operator=( const ScopedTimer & );   // not copyable
+
+        StatsRecord * const                   m_record;
+        const Stage::VALUE                    m_stage;
+        std::chrono::steady_clock::time_point m_start;
+};
+
+} //namespace imageshrink
+
+#endif //SCOPEDTIMER_H_
@@ -0,0 +1,149 @@
+
+// include system headers
+#include <cstdio>       // snprintf
+#include <iomanip>
+
+// include own headers
+#include "StatsRecord.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+// ...
+
+namespace imageshrink
+{
+
+thread_local StatsRecord * StatsRecord::s_current = nullptr;
+
+StatsRecord::StatsRecord()
+: m_nofAllocations( 0 )
+, m_bytesAllocated( 0 )
+, m_nofPoolHits( 0 )
+, m_nofPoolMisses( 0 )
+, m_nofRounds( 0 )
+, m_candidates()
+{
+    for( int i = 0; i < Stage::nofValues; ++i )
+    {
+        m_nofCalls[i]    = 0;
+        m_nanoseconds[i] = 0;
+    }
+}
+
+void StatsRecord::addTime( Stage::VALUE stage, long long nanoseconds )
+{
+    ++m_nofCalls[ stage ];
+    m_nanoseconds[ stage ] += nanoseconds;
+}
+
+void StatsRecord::addAllocation( std::size_t bytes )
+{
+    ++m_nofAllocations;
+    m_bytesAllocated += bytes;
+}
+
+void StatsRecord::addPoolRequest( bool hit )
+{
+    if( hit )
+    {
+        ++m_nofPoolHits;
+    }
+    else
+    {
+        ++m_nofPoolMisses;
+    }
+}
+
+void StatsRecord::addCandidate( int quality, long long size, double dssimAvg, double dssimPeak )
+{
+    Candidate candidate;
+
+    candidate.quality   = quality;
+    candidate.size      = size;
+    candidate.dssimAvg  = dssimAvg;
+    candidate.dssimPeak = dssimPeak;
+
+    m_candidates.push_back( candidate );
+}
+
+void StatsRecord::writeJsonMembers( std::ostream & os ) const
+{
+    const std::ios::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+
+    os << "\"stages\":{";
+
+    for( int i = Stage::UNKNOWN + 1; i < Stage::nofValues; ++i )
+    {
+        os << ( ( i > Stage::UNKNOWN + 1 ) ? "," : "" )
+           << "\"" << Stage::toString( static_cast<Stage::VALUE>( i ) ) << "\":{"
+           << "\"calls\":" << m_nofCalls[i]
+           << ",\"ms\":" << std::fixed << std::setprecision( 3 ) << ( m_nanoseconds[i] / 1.0e6 )
+           << "}";
+    }
+
+    os.flags( flags );
+    os.precision( precision );
+
+    os << "},\"allocations\":{\"count\":" << m_nofAllocations << ",\"bytes\":" << m_bytesAllocated << "}"
+       << ",\"bufferPool\":{\"hits\":" << m_nofPoolHits << ",\"misses\":" << m_nofPoolMisses << "}"
+       << ",\"rounds\":" << m_nofRounds
+       << ",\"candidates\":[";
+
+    os.unsetf( std::ios::floatfield );
+    os << std::setprecision( 9 );
+
+    for( std::size_t i = 0; i < m_candidates.size(); ++i )
+    {
+        const Candidate & candidate = m_candidates[i];
+
+        os << ( ( i > 0 ) ? "," : "" )
+           << "{\"quality\":" << candidate.quality
+           << ",\"size\":" << candidate.size
+           << ",\"dssim\":" << candidate.dssimAvg
+           << ",\"dssimPeak\":" << candidate.dssimPeak
+           << "}";
+    }
+
+    os << "]";
+
+    os.flags( flags );
+    os.precision( precision );
+}
+
+void StatsRecord::writeJsonString( std::ostream & os, const std::string & value )
+{
+    os << '"';
+
+    for( std::string::const_iterator it = value.begin(); it != value.end(); ++it )
+    {
+        const unsigned char c = *it;
+
+        switch( c )
+        {
+            case '"':  os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n";  break;
+            case '\r': os << "\\r";  break;
+            case '\t': os << "\\t";  break;
+            default:
+                if( c < 0x20 )
+                {
+                    char escaped[8];
+                    snprintf( escaped, sizeof( escaped ), "\\u%04x", c );
+                    os << escaped;
+                }
+                else
+                {
+                    os << *it;
+                }
+                break;
+        }
+    }
+
+    os << '"';
+}
+
+} //namespace imageshrink
@@ -0,0 +1,135 @@
+
+#ifndef STATSRECORD_H_
+#define STATSRECORD_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// include application headers
+#include "enumStage.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class StatsRecord;
+typedef std::shared_ptr<StatsRecord> StatsRecordShrdPtr;
+typedef std::weak_ptr<StatsRecord>   StatsRecordWkPtr;
+
+// declaration
+// timings and counters of shrinking one image; the record is attached to
+// the threads working on the image (see StatsScope), the instrumented code
+// finds it with getCurrent(); without an attached record nothing is
+// measured. The times of a stage are summed over all threads.
+class StatsRecord
+: public std::enable_shared_from_this<StatsRecord>
+{
+    //********** PRELIMINARY **********
+    public:
+        // one evaluated quality
+        struct Candidate
+        {
+            int       quality;
+            long long size;        // in bytes; 0 if the candidate is not encoded (DCT engine)
+            double    dssimAvg;
+            double    dssimPeak;
+        };
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        StatsRecord();
+        virtual ~StatsRecord() {}
+
+    protected:
+
+    private:
+        StatsRecord( const StatsRecord & );               // not copyable
+        StatsRecord & operator=( const StatsRecord & );   // not copyable
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        static thread_local StatsRecord * s_current;
+
+        std::atomic<long long> m_nofCalls[ Stage::nofValues ];
+        std::atomic<long long> m_nanoseconds[ Stage::nofValues ];
+        std::atomic<long long> m_nofAllocations;
+        std::atomic<long long> m_bytesAllocated;
+        std::atomic<long long> m_nofPoolHits;
+        std::atomic<long long> m_nofPoolMisses;
+
+        int                    m_nofRounds;    // of the quality search
+        std::vector<Candidate> m_candidates;
+
+    //********** METHODS **********
+    public:
+        // the record of the calling thread (nullptr if there is none)
+        static StatsRecord * getCurrent() { return s_current; }
+
+        // thread safe
+        void addTime( Stage::VALUE stage, long long nanoseconds );
+        void addAllocation( std::size_t bytes );
+        void addPoolRequest( bool hit );
+
+        // not thread safe; called by the quality evaluator only
+        void addRound() { ++m_nofRounds; }
+        void addCandidate( int quality, long long size, double dssimAvg, double dssimPeak );
+
+        long long getNofCalls( Stage::VALUE stage ) const { return m_nofCalls[ stage ]; }
+        long long getNanoseconds( Stage::VALUE stage ) const { return m_nanoseconds[ stage ]; }
+        long long getNofAllocations() const { return m_nofAllocations; }
+        long long getBytesAllocated() const { return m_bytesAllocated; }
+        long long getNofPoolHits() const { return m_nofPoolHits; }
+        long long getNofPoolMisses() const { return m_nofPoolMisses; }
+        int getNofRounds() const { return m_nofRounds; }
+        const std::vector<Candidate> & getCandidates() const { return m_candidates; }
+
+        // the members "stages", "allocations", "bufferPool", "rounds" and
+        // "candidates" of a JSON object (without the braces)
+        void writeJsonMembers( std::ostream & os ) const;
+
+        // quoted and escaped JSON string
+        static void writeJsonString( std::ostream & os, const std::string & value );
+
+        friend class StatsScope;
+
+    protected:
+
+    private:
+
+}; //class
+
+// attaches a record to the calling thread for the lifetime of the scope;
+// a nullptr detaches the thread
+class StatsScope
+{
+    public:
+        explicit StatsScope( StatsRecord * record )
+        : m_previous( StatsRecord::s_current )
+        {
+            StatsRecord::s_current = record;
+        }
+
+        ~StatsScope()
+        {
+            StatsRecord::s_current = m_previous;
+        }
+
+    private:
+        StatsScope( const StatsScope & );               // not copyable
+        StatsScope & operator=( const StatsScope & );   // not copyable
+
+        StatsRecord * m_previous;
+};
+
+} //namespace imageshrink
+
+#endif //STATSRECORD_H_
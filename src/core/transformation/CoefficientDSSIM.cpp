@@ -0,0 +1,207 @@
+
+// include system headers
+#include <cmath>
+
+// include own headers
+#include "CoefficientDSSIM.h"
+
+// include application headers
+#include "ImageJfif.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+#endif //USE_LOG4CXX
+
+// quantization like libjpeg does it (round half away from zero)
+static inline int requantize( int value, int quantizationValue )
+{
+    if( value >= 0 )
+    {
+        return ( ( value + quantizationValue / 2 ) / quantizationValue ) * quantizationValue;
+    }
+    else
+    {
+        return -( ( ( -value + quantizationValue / 2 ) / quantizationValue ) * quantizationValue );
+    }
+}
+
+CoefficientDSSIM::CoefficientDSSIM( ImageJfifCoefficientsShrdPtr coefficients, int averaging )
+: m_coefficients( coefficients )
+, m_averaging( averaging )
+, m_blocksPerChunk( 0 )
+, m_widthInChunks( 0 )
+, m_heightInChunks( 0 )
+, m_originalChunks()
+{
+    calcOriginalChunks();
+}
+
+void CoefficientDSSIM::calcOriginalChunks()
+{
+    if(    ( !m_coefficients )
+        || ( !m_coefficients->isValid() )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "no DCT coefficients available" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+    if( ( m_averaging % 8 ) != 0 )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "chunk size " << m_averaging << " is not a multiple of the DCT block size" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+    // like ImageAverage, incomplete chunks at the right and bottom border are ignored
+    m_blocksPerChunk = m_averaging / 8;
+    m_widthInChunks  = m_coefficients->getWidth() / m_averaging;
+    m_heightInChunks = m_coefficients->getHeight() / m_averaging;
+
+    m_originalChunks.resize( m_widthInChunks * m_heightInChunks );
+
+    const unsigned short * const quantizationTable = m_coefficients->getQuantizationTable();
+
+    #pragma omp parallel for
+    for( int yChunk = 0; yChunk < m_heightInChunks; ++yChunk )
+    {
+        for( int xChunk = 0; xChunk < m_widthInChunks; ++xChunk )
+        {
+            double sum = 0.0;
+            double sumOfSquares = 0.0;
+
+            for( int yBlock = yChunk * m_blocksPerChunk; yBlock < ( yChunk + 1 ) * m_blocksPerChunk; ++yBlock )
+            {
+                for( int xBlock = xChunk * m_blocksPerChunk; xBlock < ( xChunk + 1 ) * m_blocksPerChunk; ++xBlock )
+                {
+                    const short * const block = m_coefficients->getBlock( xBlock, yBlock );
+
+                    // the DC coefficient is 1/8 of the block sum; the DCT is
+                    // orthonormal, so the sum of squares is kept (Parseval)
+                    sum += 8.0 * block[0] * quantizationTable[0];
+
+                    for( int i = 0; i < 64; ++i )
+                    {
+                        const double value = block[i] * quantizationTable[i];
+                        sumOfSquares += value * value;
+                    }
+                }
+            }
+
+            ChunkSums & chunk = m_originalChunks[ yChunk * m_widthInChunks + xChunk ];
+            chunk.sum          = sum;
+            chunk.sumOfSquares = sumOfSquares;
+        }
+    }
+}
+
+bool CoefficientDSSIM::compare( int quality, double & dssim, double & dssimPeak ) const
+{
+    if( !isValid() )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "DSSIM in the DCT domain is not available" );
+#endif //USE_LOG4CXX
+        return false;
+    }
+
+    const unsigned short * const quantizationTableOld = m_coefficients->getQuantizationTable();
+    const ImageJfif::QuantizationTableShrdPtr quantizationTableNew = ImageJfif::getStandardQuantizationTable( quality, 0 );
+
+    // constants for SSIM (same as ImageDSSIM)
+    const double ssimL  = 255;   // 2**(#bits per pixel) - 1
+    const double ssimK1 = 0.01;
+    const double ssimK2 = 0.03;
+    const double ssimC1 = pow( ssimK1 * ssimL, 2.0 );
+    const double ssimC2 = pow( ssimK2 * ssimL, 2.0 );
+
+    const double nofPixels = static_cast<double>( m_averaging * m_averaging );
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate SSIM from DCT coefficients ..." );
+#endif //USE_LOG4CXX
+
+    double dssimSum = 0.0;
+    double dssimMax = -1.0;
+
+    #pragma omp parallel for reduction(+:dssimSum) reduction(max:dssimMax)
+    for( int yChunk = 0; yChunk < m_heightInChunks; ++yChunk )
+    {
+        for( int xChunk = 0; xChunk < m_widthInChunks; ++xChunk )
+        {
+            double sum = 0.0;
+            double sumOfSquares = 0.0;
+            double sumOfProducts = 0.0;
+
+            for( int yBlock = yChunk * m_blocksPerChunk; yBlock < ( yChunk + 1 ) * m_blocksPerChunk; ++yBlock )
+            {
+                for( int xBlock = xChunk * m_blocksPerChunk; xBlock < ( xChunk + 1 ) * m_blocksPerChunk; ++xBlock )
+                {
+                    const short * const block = m_coefficients->getBlock( xBlock, yBlock );
+
+                    for( int i = 0; i < 64; ++i )
+                    {
+                        const int valueOld = block[i] * quantizationTableOld[i];
+
+                        if( valueOld == 0 )
+                        {
+                            continue;
+                        }
+
+                        const double valueNew = requantize( valueOld, quantizationTableNew->values[i] );
+
+                        sumOfSquares  += valueNew * valueNew;
+                        sumOfProducts += valueNew * valueOld;
+                    }
+
+                    sum += 8.0 * requantize( block[0] * quantizationTableOld[0], quantizationTableNew->values[0] );
+                }
+            }
+
+            const ChunkSums & chunk = m_originalChunks[ yChunk * m_widthInChunks + xChunk ];
+
+            // sums are relative to 128; this shifts the means only
+            const double mean1 = chunk.sum / nofPixels;
+            const double mean2 = sum / nofPixels;
+
+            const double averaging1Pixel = ( mean1 + 128.0 ) / ssimL;
+            const double averaging2Pixel = ( mean2 + 128.0 ) / ssimL;
+            const double variance1Pixel  = ( chunk.sumOfSquares / nofPixels - mean1 * mean1 ) / ssimL;
+            const double variance2Pixel  = ( sumOfSquares / nofPixels - mean2 * mean2 ) / ssimL;
+            const double covariancePixel = ( sumOfProducts / nofPixels - mean1 * mean2 ) / ssimL;
+
+            const double ssim = ( ( 2.0 * averaging1Pixel * averaging2Pixel + ssimC1 ) * ( 2.0 * covariancePixel + ssimC2 ) )
+                                /
+                                ( ( averaging1Pixel * averaging1Pixel + averaging2Pixel * averaging2Pixel + ssimC1 ) * ( variance1Pixel + variance2Pixel + ssimC2 ) );
+
+            const double dssimChunk = ( 1.0 - ssim ) / 2.0;
+
+            dssimSum += dssimChunk;
+
+            if( dssimChunk > dssimMax )
+                dssimMax = dssimChunk;
+        }
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate SSIM from DCT coefficients ... done" );
+#endif //USE_LOG4CXX
+
+    dssim     = dssimSum / static_cast<double>( m_widthInChunks * m_heightInChunks );
+    dssimPeak = dssimMax;
+
+    return true;
+}
+
+} //namespace imageshrink
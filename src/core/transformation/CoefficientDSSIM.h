@@ -0,0 +1,78 @@
+
+#ifndef COEFFICIENTDSSIM_H_
+#define COEFFICIENTDSSIM_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+
+// include application headers
+#include "ImageJfifCoefficients.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class CoefficientDSSIM;
+typedef std::shared_ptr<CoefficientDSSIM> CoefficientDSSIMShrdPtr;
+typedef std::weak_ptr<CoefficientDSSIM>   CoefficientDSSIMWkPtr;
+
+// declaration
+// DSSIM of the luminance between the source and the source requantized
+// with the tables of a given quality; all statistics are computed from
+// the DCT coefficients (no IDCT, no colour conversion)
+class CoefficientDSSIM
+: public std::enable_shared_from_this<CoefficientDSSIM>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    private:
+        // statistics of one chunk relative to 128 (sums over all pixels)
+        struct ChunkSums
+        {
+            double sum;
+            double sumOfSquares;
+        };
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        CoefficientDSSIM( ImageJfifCoefficientsShrdPtr coefficients, int averaging );
+        virtual ~CoefficientDSSIM() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        ImageJfifCoefficientsShrdPtr m_coefficients;
+        int                          m_averaging;
+        int                          m_blocksPerChunk;   // in each direction
+        int                          m_widthInChunks;
+        int                          m_heightInChunks;
+
+        std::vector<ChunkSums>       m_originalChunks;
+
+    //********** METHODS **********
+    public:
+        // the chunks have to consist of complete 8x8 blocks
+        bool isValid() const { return !m_originalChunks.empty(); }
+
+        // thread safe; returns false if the engine is not valid
+        bool compare( int quality, double & dssim, double & dssimPeak ) const;
+
+    protected:
+
+    private:
+        void calcOriginalChunks();
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //COEFFICIENTDSSIM_H_
@@ -0,0 +1,225 @@
+
+// include system headers
+#include <algorithm>    // std::min
+#include <vector>
+
+// include own headers
+#include "GaussianSSIM.h"
+
+// include application headers
+#include "GaussianFilter.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+#endif //USE_LOG4CXX
+
+// filtered quantities per pixel
+enum
+{
+    MEAN1,
+    MEAN2,
+    SQUARES1,
+    SQUARES2,
+    PRODUCTS,
+    NOF_QUANTITIES
+};
+
+GaussianSSIM::GaussianSSIM( ImageReferenceContextShrdPtr reference )
+: m_reference( reference )
+{
+    calcGaussianWeights( m_weights, nofTaps, 1.5 );
+}
+
+bool GaussianSSIM::isValid() const
+{
+    return    ( m_reference )
+           && ( m_reference->isValid() )
+           && ( m_reference->getWidth() >= nofTaps )
+           && ( m_reference->getHeight() >= nofTaps );
+}
+
+bool GaussianSSIM::compare( const ImageInterface & candidate, double & dssim, double & dssimPeak ) const
+{
+    ImageBufferShrdPtr imageBuffer = candidate.getImageBuffer();
+    int bytesPerPixel = 0;
+    int bytesPerLine  = 0;
+
+    if(    ( !isValid() )
+        || ( !imageBuffer )
+        || ( m_reference->getPixelFormat() != candidate.getPixelFormat() )
+        || ( m_reference->getWidth() != candidate.getWidth() )
+        || ( m_reference->getHeight() != candidate.getHeight() )
+        || ( !ImageReferenceContext::getFirstPlaneLayout( candidate, bytesPerPixel, bytesPerLine ) )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "Gaussian SSIM is not applicable (" << __FILE__ << ", " << __LINE__ << ")" );
+#endif //USE_LOG4CXX
+        return false;
+    }
+
+    const ImageReferenceContext & reference = *m_reference;
+    const unsigned char * const plane = imageBuffer->image;
+    const GaussianFilterImplementation & filter = getGaussianFilter();
+
+    // constants for SSIM
+    const float ssimL  = 255;   // 2**(#bits per pixel) - 1
+    const float ssimC1 = ( 0.01f * ssimL ) * ( 0.01f * ssimL );
+    const float ssimC2 = ( 0.03f * ssimL ) * ( 0.03f * ssimL );
+
+    // only windows completely inside the image are used
+    const int outWidth  = reference.getWidth() - nofTaps + 1;
+    const int outHeight = reference.getHeight() - nofTaps + 1;
+    const int averaging = reference.getAveraging();
+
+    const int widthInChunks  = outWidth / averaging;
+    const int heightInChunks = outHeight / averaging;
+    std::vector<double> chunkSums( widthInChunks * heightInChunks, 0.0 );
+
+    const int widthInTiles  = ( outWidth + tileWidth - 1 ) / tileWidth;
+    const int heightInTiles = ( outHeight + tileHeight - 1 ) / tileHeight;
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate Gaussian SSIM (" << filter.name << ") ..." );
+#endif //USE_LOG4CXX
+
+    double ssimSum = 0.0;
+
+    #pragma omp parallel reduction(+:ssimSum)
+    {
+        const int inputWidth  = tileWidth + nofTaps - 1;
+        const int inputHeight = tileHeight + nofTaps - 1;
+
+        std::vector<float> input( NOF_QUANTITIES * inputWidth );                       // one line
+        std::vector<float> filtered( NOF_QUANTITIES * inputHeight * tileWidth );       // filtered horizontally
+        std::vector<float> means( NOF_QUANTITIES * tileWidth );                        // filtered in both directions
+        std::vector<float> ssimLine( tileWidth );
+        const float * columns[ nofTaps ];
+
+        #pragma omp for schedule(dynamic, 1)
+        for( int tile = 0; tile < widthInTiles * heightInTiles; ++tile )
+        {
+            const int x0 = ( tile % widthInTiles ) * tileWidth;
+            const int y0 = ( tile / widthInTiles ) * tileHeight;
+            const int nofOutPixels = std::min( tileWidth, outWidth - x0 );
+            const int nofOutLines  = std::min( tileHeight, outHeight - y0 );
+            const int nofInPixels  = nofOutPixels + nofTaps - 1;
+            const int nofInLines   = nofOutLines + nofTaps - 1;
+
+            // horizontal pass
+            for( int line = 0; line < nofInLines; ++line )
+            {
+                const unsigned char * const line1 = reference.getPlaneLine( y0 + line ) + x0;
+                const unsigned char * const line2 = &plane[ ( y0 + line ) * bytesPerLine + x0 * bytesPerPixel ];
+
+                float * const in1  = &input[ MEAN1 * inputWidth ];
+                float * const in2  = &input[ MEAN2 * inputWidth ];
+                float * const in11 = &input[ SQUARES1 * inputWidth ];
+                float * const in22 = &input[ SQUARES2 * inputWidth ];
+                float * const in12 = &input[ PRODUCTS * inputWidth ];
+
+                for( int x = 0; x < nofInPixels; ++x )
+                {
+                    const float value1 = line1[x];
+                    const float value2 = line2[ x * bytesPerPixel ];
+
+                    in1[x]  = value1;
+                    in2[x]  = value2;
+                    in11[x] = value1 * value1;
+                    in22[x] = value2 * value2;
+                    in12[x] = value1 * value2;
+                }
+
+                for( int q = 0; q < NOF_QUANTITIES; ++q )
+                {
+                    filter.filterLine( &input[ q * inputWidth ], m_weights, nofTaps, &filtered[ ( q * inputHeight + line ) * tileWidth ], nofOutPixels );
+                }
+            }
+
+            // vertical pass and SSIM per pixel
+            for( int line = 0; line < nofOutLines; ++line )
+            {
+                for( int q = 0; q < NOF_QUANTITIES; ++q )
+                {
+                    for( int k = 0; k < nofTaps; ++k )
+                    {
+                        columns[k] = &filtered[ ( q * inputHeight + line + k ) * tileWidth ];
+                    }
+
+                    filter.filterColumns( columns, m_weights, nofTaps, &means[ q * tileWidth ], nofOutPixels );
+                }
+
+                const float * const mean1    = &means[ MEAN1 * tileWidth ];
+                const float * const mean2    = &means[ MEAN2 * tileWidth ];
+                const float * const squares1 = &means[ SQUARES1 * tileWidth ];
+                const float * const squares2 = &means[ SQUARES2 * tileWidth ];
+                const float * const products = &means[ PRODUCTS * tileWidth ];
+
+                for( int x = 0; x < nofOutPixels; ++x )
+                {
+                    const float variance1  = squares1[x] - mean1[x] * mean1[x];
+                    const float variance2  = squares2[x] - mean2[x] * mean2[x];
+                    const float covariance = products[x] - mean1[x] * mean2[x];
+
+                    ssimLine[x] = ( ( 2.0f * mean1[x] * mean2[x] + ssimC1 ) * ( 2.0f * covariance + ssimC2 ) )
+                                  /
+                                  ( ( mean1[x] * mean1[x] + mean2[x] * mean2[x] + ssimC1 ) * ( variance1 + variance2 + ssimC2 ) );
+                }
+
+                // sums per chunk; the line is split at the chunk borders
+                const int yChunk = ( y0 + line ) / averaging;
+
+                for( int x = 0; x < nofOutPixels; )
+                {
+                    const int xChunk = ( x0 + x ) / averaging;
+                    const int end    = std::min( nofOutPixels, ( xChunk + 1 ) * averaging - x0 );
+                    double segmentSum = 0.0;
+
+                    for( ; x < end; ++x )
+                    {
+                        segmentSum += ssimLine[x];
+                    }
+
+                    ssimSum += segmentSum;
+
+                    if(    ( xChunk < widthInChunks )
+                        && ( yChunk < heightInChunks )
+                      )
+                    {
+                        #pragma omp atomic
+                        chunkSums[ yChunk * widthInChunks + xChunk ] += segmentSum;
+                    }
+                }
+            }
+        }
+    }
+
+    dssim = ( 1.0 - ssimSum / ( static_cast<double>( outWidth ) * outHeight ) ) / 2.0;
+
+    // images smaller than one chunk have no peak of their own
+    dssimPeak = ( chunkSums.empty() ) ? dssim : -1.0;
+
+    for( std::size_t i = 0; i < chunkSums.size(); ++i )
+    {
+        const double dssimChunk = ( 1.0 - chunkSums[i] / ( static_cast<double>( averaging ) * averaging ) ) / 2.0;
+
+        if( dssimChunk > dssimPeak )
+            dssimPeak = dssimChunk;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate Gaussian SSIM ... done" );
+#endif //USE_LOG4CXX
+
+    return true;
+}
+
+} //namespace imageshrink
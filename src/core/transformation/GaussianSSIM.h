@@ -0,0 +1,68 @@
+
+#ifndef GAUSSIANSSIM_H_
+#define GAUSSIANSSIM_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "ImageInterface.h"
+#include "ImageReferenceContext.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class GaussianSSIM;
+typedef std::shared_ptr<GaussianSSIM> GaussianSSIMShrdPtr;
+typedef std::weak_ptr<GaussianSSIM>   GaussianSSIMWkPtr;
+
+// declaration
+// SSIM with the 11x11 Gaussian window (sigma 1.5) of Wang et al. at every
+// pixel of the first plane. The window filter is separable and runs on
+// float lines. The image is processed in tiles, so the filtered lines of
+// a tile stay in the L2 cache. The average DSSIM is taken over all
+// windows, the peak DSSIM over the averages of the chunks.
+class GaussianSSIM
+: public std::enable_shared_from_this<GaussianSSIM>
+{
+    //********** PRELIMINARY **********
+    public:
+        static const int nofTaps    = 11;
+        static const int tileWidth  = 256;   // in output pixels
+        static const int tileHeight = 32;    // in output lines
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        GaussianSSIM( ImageReferenceContextShrdPtr reference );
+        virtual ~GaussianSSIM() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        ImageReferenceContextShrdPtr m_reference;
+        float                        m_weights[ nofTaps ];
+
+    //********** METHODS **********
+    public:
+        bool isValid() const;
+
+        // thread safe; returns false if the candidate does not match the reference
+        bool compare( const ImageInterface & candidate, double & dssim, double & dssimPeak ) const;
+
+    protected:
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //GAUSSIANSSIM_H_
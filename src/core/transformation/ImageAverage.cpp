@@ -7,6 +7,10 @@
 
 // include application headers
 #include "PlanarImageCalc.h"
+#include "BufferPool.h"
+#include "PlaneBands.h"
+#include "ByteSums.h"
+#include "ScopedTimer.h"
 
 // include 3rd party headers
 #ifdef USE_LOG4CXX
@@ -20,6 +24,25 @@ namespace imageshrink
 static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
 #endif //USE_LOG4CXX
 
+// the segments of a small averaging (e.g. the 2x2 of an image pyramid) are
+// summed inline; the call of the dispatched kernel does not pay off there
+static inline int sumOfSegment( const unsigned char * data, int count )
+{
+    if( count > 4 )
+    {
+        return sumOfBytes( data, count );
+    }
+
+    int sum = 0;
+
+    for( int i = 0; i < count; ++i )
+    {
+        sum += data[i];
+    }
+
+    return sum;
+}
+
 ImageAverage::ImageAverage()
 : m_averaging( 8 )
 , m_pixelFormat( PixelFormat::UNKNOWN )
@@ -49,6 +72,7 @@ ImageAverage::ImageAverage( const ImageInterface & image, int averaging )
 , m_width( 0 )
 , m_height( 0 )
 {
+    ScopedTimer timer( Stage::AVERAGE );
     reset();
     ImageAverage avg;
 
@@ -128,7 +152,7 @@ ImageAverage ImageAverage::calcAverageImage_RGB( const ImageInterface & image )
     const int nofPixels     = image.getWidth() * image.getHeight();
     const int bufferSize    = bytesPerPixel * nofPixels;
 
-    if( bufferSize != imageBuffer->size )
+    if( static_cast<std::size_t>( bufferSize ) != imageBuffer->size )
     {
 #ifdef USE_LOG4CXX
         LOG4CXX_ERROR( loggerTransformation, "buffer size mismatch (" << __FILE__ << ", " << __LINE__ << ")" );
@@ -154,14 +178,14 @@ ImageAverage ImageAverage::calcAverageImage_RGB( const ImageInterface & image )
     );
 #endif //USE_LOG4CXX
 
-    ImageBufferShrdPtr newImageBuffer = std::make_shared<ImageBuffer>( newBufferSize );
+    ImageBufferShrdPtr newImageBuffer = BufferPool::getInstance().getBuffer( newBufferSize );
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerTransformation, "averaging ..." );
 #endif //USE_LOG4CXX
 
     int bytesPerLine = image.getWidth() * bytesPerPixel;
-    int bytesPerNewLine = bytesPerLine / m_averaging;
+    int bytesPerNewLine = newWidth * bytesPerPixel;   // the incomplete chunk at the right border is dropped
 
     #pragma omp parallel for
     for( int yNew = 0; yNew < newHeight; ++yNew )
@@ -175,17 +199,20 @@ ImageAverage ImageAverage::calcAverageImage_RGB( const ImageInterface & image )
             const int xNewByteOffset = bytesPerPixel * xNew;
             const int yNewByteOffset = bytesPerNewLine * yNew;
 
-            for( int xWindow = 0; xWindow < m_averaging; ++xWindow )
+            // line by line; each line segment of the window is contiguous
+            for( int yWindow = 0; yWindow < m_averaging; ++yWindow )
             {
-                const int xWindowByteOffset = bytesPerPixel * ( xNew * m_averaging + xWindow );
+                const int yWindowByteOffset = bytesPerLine * ( yNew * m_averaging + yWindow );
+                const int xWindowByteOffset = bytesPerPixel * ( xNew * m_averaging );
 
-                for( int yWindow = 0; yWindow < m_averaging; ++yWindow )
-                {
-                    const int yWindowByteOffset = bytesPerLine * ( yNew * m_averaging + yWindow );
-                    sumAvgCh1 += imageBuffer->image[ xWindowByteOffset + yWindowByteOffset + 0 ];
-                    sumAvgCh2 += imageBuffer->image[ xWindowByteOffset + yWindowByteOffset + 1 ];
-                    sumAvgCh3 += imageBuffer->image[ xWindowByteOffset + yWindowByteOffset + 2 ];
-                }
+                int sumCh1 = 0;
+                int sumCh2 = 0;
+                int sumCh3 = 0;
+                sumOfBytes3( &imageBuffer->image[ xWindowByteOffset + yWindowByteOffset ], m_averaging, sumCh1, sumCh2, sumCh3 );
+
+                sumAvgCh1 += sumCh1;
+                sumAvgCh2 += sumCh2;
+                sumAvgCh3 += sumCh3;
             }
 
             const int avgAvg = m_averaging * m_averaging;
@@ -286,7 +313,7 @@ ImageAverage ImageAverage::calcAverageImage_YUV( const ImageInterface & image )
     PlanarImageDesc planaImageNew = calcPlanaerImageDescForYUV( newWidth, newHeight, cs, TJ_PAD );
     PlanarImageDesc planaImageOld = calcPlanaerImageDescForYUV( oldWidth, oldHeight, cs, TJ_PAD );
 
-    ImageBufferShrdPtr imageBufferNew = std::make_shared<ImageBuffer>( planaImageNew.bufferSize );
+    ImageBufferShrdPtr imageBufferNew = BufferPool::getInstance().getBuffer( planaImageNew.bufferSize );
     ImageBufferShrdPtr imageBufferOld = image.getImageBuffer();
 
     if(    ( !imageBufferNew )
@@ -327,128 +354,61 @@ ImageAverage ImageAverage::calcAverageImage_YUV( const ImageInterface & image )
     LOG4CXX_INFO( loggerTransformation, "averaging ..." );
 #endif //USE_LOG4CXX
 
-    unsigned char * const plane0New = &imageBufferNew->image[ 0 ];
-    unsigned char * const plane1New = &imageBufferNew->image[ planaImageNew.planeSize0 ];
-    unsigned char * const plane2New = &imageBufferNew->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
-
-    const unsigned char * const plane0Old = &imageBufferOld->image[ 0 ];
-    const unsigned char * const plane1Old = &imageBufferOld->image[ planaImageOld.planeSize0 ];
-    const unsigned char * const plane2Old = &imageBufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ];
-
-    // determine new image
-    #pragma omp parallel sections
-    {
-        // create chroma plane
-        #pragma omp section
-        {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride0;
-            const int bytesPerOldLine = planaImageOld.stride0;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height0; ++yNew )
-            {
-                for( int xNew = 0; xNew < planaImageNew.width0; ++xNew )
-                {
-                    int sum = 0;
-
-                    for( int yOldOffset = 0; yOldOffset < m_averaging; ++yOldOffset )
-                    {
-                        const int yOld = yNew * m_averaging + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < m_averaging; ++xOldOffset )
-                        {
-                            const int xOld = xNew * m_averaging + xOldOffset;
+    unsigned char * const planesNew[3] = { &imageBufferNew->image[ 0 ],
+                                           &imageBufferNew->image[ planaImageNew.planeSize0 ],
+                                           &imageBufferNew->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ] };
 
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
+    const unsigned char * const planesOld[3] = { &imageBufferOld->image[ 0 ],
+                                                 &imageBufferOld->image[ planaImageOld.planeSize0 ],
+                                                 &imageBufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ] };
 
-                            sum += plane0Old[ xOldByteOffset + yOldByteOffset ];
-                        }
-                    }
+    const int stridesNew[3] = { planaImageNew.stride0, planaImageNew.stride1, planaImageNew.stride2 };
+    const int stridesOld[3] = { planaImageOld.stride0, planaImageOld.stride1, planaImageOld.stride2 };
+    const int widthsNew[3]  = { planaImageNew.width0, planaImageNew.width1, planaImageNew.width2 };
+    const int heightsNew[3] = { planaImageNew.height0, planaImageNew.height1, planaImageNew.height2 };
+    const int averagingX[3] = { m_averaging, chromaAveragingX, chromaAveragingX };
+    const int averagingY[3] = { m_averaging, chromaAveragingY, chromaAveragingY };
 
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
+    // a new line costs all old pixels of its chunks
+    const int costPerLine[3] = { widthsNew[0] * averagingX[0] * averagingY[0],
+                                 widthsNew[1] * averagingX[1] * averagingY[1],
+                                 widthsNew[2] * averagingX[2] * averagingY[2] };
 
-                    plane0New[ xNewByteOffset + yNewByteOffset ] = sum / ( m_averaging * m_averaging );
-                }
-            }
-        }
-
-        // create U/Cb plane
-        #pragma omp section
+    // determine new image; the lines of all planes are distributed over the threads together
+    runPlaneBands( calcPlaneBands( costPerLine, heightsNew, 3 ), [&]( int plane, int yBegin, int yEnd )
+    {
+        const int bytesPerPixel = 1;
+        const int bytesPerNewLine = stridesNew[ plane ];
+        const int bytesPerOldLine = stridesOld[ plane ];
+        const int averagingPlaneX = averagingX[ plane ];
+        const int averagingPlaneY = averagingY[ plane ];
+        unsigned char * const planeNew = planesNew[ plane ];
+        const unsigned char * const planeOld = planesOld[ plane ];
+
+        for( int yNew = yBegin; yNew < yEnd; ++yNew )
         {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride1;
-            const int bytesPerOldLine = planaImageOld.stride1;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height1; ++yNew )
+            for( int xNew = 0; xNew < widthsNew[ plane ]; ++xNew )
             {
-                for( int xNew = 0; xNew < planaImageNew.width1; ++xNew )
-                {
-                    int sum = 0;
+                int sum = 0;
 
-                    for( int yOldOffset = 0; yOldOffset < chromaAveragingY; ++yOldOffset )
-                    {
-                        const int yOld = yNew * chromaAveragingY + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < chromaAveragingX; ++xOldOffset )
-                        {
-                            const int xOld = xNew * chromaAveragingX + xOldOffset;
-
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
-
-                            sum += plane1Old[ xOldByteOffset + yOldByteOffset ];
-                        }
-                    }
-
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
-
-                    plane1New[ xNewByteOffset + yNewByteOffset ] = sum / ( chromaAveragingX * chromaAveragingY );
-                }
-            }
-        }
-
-        // create V/Cr plane
-        #pragma omp section
-        {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride2;
-            const int bytesPerOldLine = planaImageOld.stride2;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height2; ++yNew )
-            {
-                for( int xNew = 0; xNew < planaImageNew.width2; ++xNew )
+                for( int yOldOffset = 0; yOldOffset < averagingPlaneY; ++yOldOffset )
                 {
-                    int sum = 0;
+                    const int yOld = yNew * averagingPlaneY + yOldOffset;
+                    const int xOld = xNew * averagingPlaneX;
 
-                    for( int yOldOffset = 0; yOldOffset < chromaAveragingY; ++yOldOffset )
-                    {
-                        const int yOld = yNew * chromaAveragingY + yOldOffset;
+                    const int xOldByteOffset = bytesPerPixel * xOld;
+                    const int yOldByteOffset = bytesPerOldLine * yOld;
 
-                        for( int xOldOffset = 0; xOldOffset < chromaAveragingX; ++xOldOffset )
-                        {
-                            const int xOld = xNew * chromaAveragingX + xOldOffset;
-
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
-
-                            sum += plane2Old[ xOldByteOffset + yOldByteOffset ];
-                        }
-                    }
+                    sum += sumOfSegment( &planeOld[ xOldByteOffset + yOldByteOffset ], averagingPlaneX );
+                }
 
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
+                const int xNewByteOffset = bytesPerPixel * xNew;
+                const int yNewByteOffset = bytesPerNewLine * yNew;
 
-                    plane2New[ xNewByteOffset + yNewByteOffset ] = sum / ( chromaAveragingX * chromaAveragingY );
-                }
+                planeNew[ xNewByteOffset + yNewByteOffset ] = sum / ( averagingPlaneX * averagingPlaneY );
             }
         }
-    }
+    } );
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerTransformation, "averaging ... done" );
@@ -7,6 +7,9 @@
 
 // include application headers
 #include "PlanarImageCalc.h"
+#include "BufferPool.h"
+#include "PlaneBands.h"
+#include "ScopedTimer.h"
 
 // include 3rd party headers
 #ifdef USE_LOG4CXX
@@ -49,6 +52,7 @@ ImageCovariance::ImageCovariance( const ImageInterface & image1, const ImageInte
 , m_width( 0 )
 , m_height( 0 )
 {
+    ScopedTimer timer( Stage::COVARIANCE );
     reset();
     ImageCovariance var;
 
@@ -159,8 +163,8 @@ ImageCovariance ImageCovariance::calcCovarianceImage_RGB( const ImageInterface &
     const int nofPixels     = image1.getWidth() * image1.getHeight();
     const int bufferSize    = bytesPerPixel * nofPixels;
 
-    if(    ( bufferSize != imageBuffer1->size )
-        || ( bufferSize != imageBuffer2->size )
+    if(    ( static_cast<std::size_t>( bufferSize ) != imageBuffer1->size )
+        || ( static_cast<std::size_t>( bufferSize ) != imageBuffer2->size )
       )
     {
 #ifdef USE_LOG4CXX
@@ -187,7 +191,9 @@ ImageCovariance ImageCovariance::calcCovarianceImage_RGB( const ImageInterface &
     );
 #endif //USE_LOG4CXX
 
-    ImageBufferShrdPtr newImageBuffer = std::make_shared<ImageBuffer>( newBufferSize );
+    // float per channel; negative covariances are kept
+    ImageBufferShrdPtr newImageBuffer = BufferPool::getInstance().getBuffer( newBufferSize * sizeof( float ) );
+    float * const newPlanes = reinterpret_cast<float *>( newImageBuffer->image );
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerTransformation, "averaging ..." );
@@ -237,9 +243,9 @@ ImageCovariance ImageCovariance::calcCovarianceImage_RGB( const ImageInterface &
             }
 
             const int avgAvg = m_averaging * m_averaging;
-            newImageBuffer->image[ xNewByteOffset + yNewByteOffset + 0 ] = sumCh1 / avgAvg;
-            newImageBuffer->image[ xNewByteOffset + yNewByteOffset + 1 ] = sumCh2 / avgAvg;
-            newImageBuffer->image[ xNewByteOffset + yNewByteOffset + 2 ] = sumCh3 / avgAvg;
+            newPlanes[ xNewByteOffset + yNewByteOffset + 0 ] = static_cast<float>( sumCh1 ) / avgAvg;
+            newPlanes[ xNewByteOffset + yNewByteOffset + 1 ] = static_cast<float>( sumCh2 ) / avgAvg;
+            newPlanes[ xNewByteOffset + yNewByteOffset + 2 ] = static_cast<float>( sumCh3 ) / avgAvg;
         }
     }
 
@@ -250,7 +256,7 @@ ImageCovariance ImageCovariance::calcCovarianceImage_RGB( const ImageInterface &
     // collect data
     ret.m_pixelFormat            = image1.getPixelFormat();
     ret.m_colorspace             = image1.getColorspace();
-    ret.m_bitsPerPixelAndChannel = image1.getBitsPerPixelAndChannel();
+    ret.m_bitsPerPixelAndChannel = BitsPerPixelAndChannel::BITS_32;
     ret.m_chrominanceSubsampling = image1.getChrominanceSubsampling();
     ret.m_imageBuffer            = newImageBuffer;
     ret.m_width                  = newWidth;
@@ -380,7 +386,7 @@ ImageCovariance ImageCovariance::calcCovarianceImage_YUV( const ImageInterface &
     PlanarImageDesc planaImageNew = calcPlanaerImageDescForYUV( newWidth, newHeight, cs, TJ_PAD );
     PlanarImageDesc planaImageOld = calcPlanaerImageDescForYUV( oldWidth, oldHeight, cs, TJ_PAD );
 
-    ImageBufferShrdPtr imageBufferNew = std::make_shared<ImageBuffer>( planaImageNew.bufferSize );
+    ImageBufferShrdPtr imageBufferNew = BufferPool::getInstance().getBuffer( planaImageNew.bufferSize * sizeof( float ) );
     ImageBufferShrdPtr image1BufferOld = image1.getImageBuffer();
     ImageBufferShrdPtr image2BufferOld = image2.getImageBuffer();
     ImageBufferShrdPtr averageImage1BufferOld = averageImage1.getImageBuffer();
@@ -416,152 +422,86 @@ ImageCovariance ImageCovariance::calcCovarianceImage_YUV( const ImageInterface &
     LOG4CXX_INFO( loggerTransformation, "determine convariance ..." );
 #endif //USE_LOG4CXX
 
-    unsigned char * const plane0New = &imageBufferNew->image[ 0 ];
-    unsigned char * const plane1New = &imageBufferNew->image[ planaImageNew.planeSize0 ];
-    unsigned char * const plane2New = &imageBufferNew->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
-
-    const unsigned char * const plane0Image1Old = &image1BufferOld->image[ 0 ];
-    const unsigned char * const plane1Image1Old = &image1BufferOld->image[ planaImageOld.planeSize0 ];
-    const unsigned char * const plane2Image1Old = &image1BufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ];
-
-    const unsigned char * const plane0Image2Old = &image2BufferOld->image[ 0 ];
-    const unsigned char * const plane1Image2Old = &image2BufferOld->image[ planaImageOld.planeSize0 ];
-    const unsigned char * const plane2Image2Old = &image2BufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ];
-
-    const unsigned char * const plane0AverageImage1Old = &averageImage1BufferOld->image[ 0 ];
-    const unsigned char * const plane1AverageImage1Old = &averageImage1BufferOld->image[ planaImageNew.planeSize0 ];
-    const unsigned char * const plane2AverageImage1Old = &averageImage1BufferOld->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
-
-    const unsigned char * const plane0AverageImage2Old = &averageImage2BufferOld->image[ 0 ];
-    const unsigned char * const plane1AverageImage2Old = &averageImage2BufferOld->image[ planaImageNew.planeSize0 ];
-    const unsigned char * const plane2AverageImage2Old = &averageImage2BufferOld->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
-
-    // determine new image
-    #pragma omp parallel sections
+    // float per sample; negative covariances are kept
+    float * const planeNew0 = reinterpret_cast<float *>( imageBufferNew->image );
+    float * const planesNew[3] = { &planeNew0[ 0 ],
+                                   &planeNew0[ planaImageNew.planeSize0 ],
+                                   &planeNew0[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ] };
+
+    const unsigned char * const planesImage1Old[3] = { &image1BufferOld->image[ 0 ],
+                                                       &image1BufferOld->image[ planaImageOld.planeSize0 ],
+                                                       &image1BufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ] };
+
+    const unsigned char * const planesImage2Old[3] = { &image2BufferOld->image[ 0 ],
+                                                       &image2BufferOld->image[ planaImageOld.planeSize0 ],
+                                                       &image2BufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ] };
+
+    const unsigned char * const planesAverageImage1Old[3] = { &averageImage1BufferOld->image[ 0 ],
+                                                              &averageImage1BufferOld->image[ planaImageNew.planeSize0 ],
+                                                              &averageImage1BufferOld->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ] };
+
+    const unsigned char * const planesAverageImage2Old[3] = { &averageImage2BufferOld->image[ 0 ],
+                                                              &averageImage2BufferOld->image[ planaImageNew.planeSize0 ],
+                                                              &averageImage2BufferOld->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ] };
+
+    const int stridesNew[3] = { planaImageNew.stride0, planaImageNew.stride1, planaImageNew.stride2 };
+    const int stridesOld[3] = { planaImageOld.stride0, planaImageOld.stride1, planaImageOld.stride2 };
+    const int widthsNew[3]  = { planaImageNew.width0, planaImageNew.width1, planaImageNew.width2 };
+    const int heightsNew[3] = { planaImageNew.height0, planaImageNew.height1, planaImageNew.height2 };
+    const int averagingX[3] = { m_averaging, chromaAveragingX, chromaAveragingX };
+    const int averagingY[3] = { m_averaging, chromaAveragingY, chromaAveragingY };
+
+    // a new line costs all old pixels of its chunks
+    const int costPerLine[3] = { widthsNew[0] * averagingX[0] * averagingY[0],
+                                 widthsNew[1] * averagingX[1] * averagingY[1],
+                                 widthsNew[2] * averagingX[2] * averagingY[2] };
+
+    // determine new image; the lines of all planes are distributed over the threads together
+    runPlaneBands( calcPlaneBands( costPerLine, heightsNew, 3 ), [&]( int plane, int yBegin, int yEnd )
     {
-        // create chroma plane
-        #pragma omp section
+        const int bytesPerPixel = 1;
+        const int bytesPerNewLine = stridesNew[ plane ];
+        const int bytesPerOldLine = stridesOld[ plane ];
+        const int averagingPlaneX = averagingX[ plane ];
+        const int averagingPlaneY = averagingY[ plane ];
+        float * const planeNew = planesNew[ plane ];
+        const unsigned char * const planeImage1Old = planesImage1Old[ plane ];
+        const unsigned char * const planeImage2Old = planesImage2Old[ plane ];
+        const unsigned char * const planeAverageImage1Old = planesAverageImage1Old[ plane ];
+        const unsigned char * const planeAverageImage2Old = planesAverageImage2Old[ plane ];
+
+        for( int yNew = yBegin; yNew < yEnd; ++yNew )
         {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride0;
-            const int bytesPerOldLine = planaImageOld.stride0;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height0; ++yNew )
+            for( int xNew = 0; xNew < widthsNew[ plane ]; ++xNew )
             {
-                for( int xNew = 0; xNew < planaImageNew.width0; ++xNew )
-                {
-                    int sum = 0;
-
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
-
-                    for( int yOldOffset = 0; yOldOffset < m_averaging; ++yOldOffset )
-                    {
-                        const int yOld = yNew * m_averaging + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < m_averaging; ++xOldOffset )
-                        {
-                            const int xOld = xNew * m_averaging + xOldOffset;
-
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
-
-                            int ch1_1  = plane0Image1Old[ xOldByteOffset + yOldByteOffset ];
-                            ch1_1     -= plane0AverageImage1Old[ xNewByteOffset + yNewByteOffset ];
-                            int ch1_2  = plane0Image2Old[ xOldByteOffset + yOldByteOffset ];
-                            ch1_2     -= plane0AverageImage2Old[ xNewByteOffset + yNewByteOffset ];
-                            sum       += ch1_1 * ch1_2;
-                        }
-                    }
+                int sum = 0;
 
-                    plane0New[ xNewByteOffset + yNewByteOffset ] = sum / ( m_averaging * m_averaging );
-                }
-            }
-        }
-
-        // create U/Cb plane
-        #pragma omp section
-        {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride1;
-            const int bytesPerOldLine = planaImageOld.stride1;
+                const int xNewByteOffset = bytesPerPixel * xNew;
+                const int yNewByteOffset = bytesPerNewLine * yNew;
 
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height1; ++yNew )
-            {
-                for( int xNew = 0; xNew < planaImageNew.width1; ++xNew )
+                for( int yOldOffset = 0; yOldOffset < averagingPlaneY; ++yOldOffset )
                 {
-                    int sum = 0;
-
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
+                    const int yOld = yNew * averagingPlaneY + yOldOffset;
 
-                    for( int yOldOffset = 0; yOldOffset < chromaAveragingY; ++yOldOffset )
+                    for( int xOldOffset = 0; xOldOffset < averagingPlaneX; ++xOldOffset )
                     {
-                        const int yOld = yNew * chromaAveragingY + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < chromaAveragingX; ++xOldOffset )
-                        {
-                            const int xOld = xNew * chromaAveragingX + xOldOffset;
+                        const int xOld = xNew * averagingPlaneX + xOldOffset;
 
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
+                        const int xOldByteOffset = bytesPerPixel * xOld;
+                        const int yOldByteOffset = bytesPerOldLine * yOld;
 
-                            int ch1_1  = plane1Image1Old[ xOldByteOffset + yOldByteOffset ];
-                            ch1_1     -= plane1AverageImage1Old[ xNewByteOffset + yNewByteOffset ];
-                            int ch1_2  = plane1Image2Old[ xOldByteOffset + yOldByteOffset ];
-                            ch1_2     -= plane1AverageImage2Old[ xNewByteOffset + yNewByteOffset ];
-                            sum       += ch1_1 * ch1_2;
-                        }
+                        int ch1_1  = planeImage1Old[ xOldByteOffset + yOldByteOffset ];
+                        ch1_1     -= planeAverageImage1Old[ xNewByteOffset + yNewByteOffset ];
+                        int ch1_2  = planeImage2Old[ xOldByteOffset + yOldByteOffset ];
+                        ch1_2     -= planeAverageImage2Old[ xNewByteOffset + yNewByteOffset ];
+                        sum       += ch1_1 * ch1_2;
                     }
-
-                    plane1New[ xNewByteOffset + yNewByteOffset ] = sum / ( chromaAveragingX * chromaAveragingY );
                 }
-            }
-        }
-
-        // create V/Cr plane
-        #pragma omp section
-        {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride2;
-            const int bytesPerOldLine = planaImageOld.stride2;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height2; ++yNew )
-            {
-                for( int xNew = 0; xNew < planaImageNew.width2; ++xNew )
-                {
-                    int sum = 0;
-
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
-
-                    for( int yOldOffset = 0; yOldOffset < chromaAveragingY; ++yOldOffset )
-                    {
-                        const int yOld = yNew * chromaAveragingY + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < chromaAveragingX; ++xOldOffset )
-                        {
-                            const int xOld = xNew * chromaAveragingX + xOldOffset;
 
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
-
-                            int ch1_1  = plane2Image1Old[ xOldByteOffset + yOldByteOffset ];
-                            ch1_1     -= plane2AverageImage1Old[ xNewByteOffset + yNewByteOffset ];
-                            int ch1_2  = plane2Image2Old[ xOldByteOffset + yOldByteOffset ];
-                            ch1_2     -= plane2AverageImage2Old[ xNewByteOffset + yNewByteOffset ];
-                            sum       += ch1_1 * ch1_2;
-                        }
-                    }
-
-                    plane2New[ xNewByteOffset + yNewByteOffset ] = sum / ( chromaAveragingX * chromaAveragingY );
-                }
+                planeNew[ xNewByteOffset + yNewByteOffset ] = static_cast<float>( sum ) / ( averagingPlaneX * averagingPlaneY );
             }
         }
-    }
+    } );
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerTransformation, "determine convariance ... done " );
@@ -570,7 +510,7 @@ ImageCovariance ImageCovariance::calcCovarianceImage_YUV( const ImageInterface &
     // collect information
     ret.m_pixelFormat = image1.getPixelFormat();
     ret.m_colorspace = image1.getColorspace();
-    ret.m_bitsPerPixelAndChannel = image1.getBitsPerPixelAndChannel();
+    ret.m_bitsPerPixelAndChannel = BitsPerPixelAndChannel::BITS_32;
     ret.m_chrominanceSubsampling = cs;
     ret.m_imageBuffer = imageBufferNew;
     ret.m_width = newWidth;
@@ -7,7 +7,9 @@
 
 // include application headers
 #include "PlanarImageCalc.h"
+#include "BufferPool.h"
 #include "ImageCovariance.h"
+#include "ScopedTimer.h"
 
 // include 3rd party headers
 #ifdef USE_LOG4CXX
@@ -49,6 +51,7 @@ ImageDSSIM::ImageDSSIM( const ImageCollection & imageCollection1, const ImageCol
 , m_dssimPeak( 0.0 )
 , m_dssimValid( false )
 {
+    ScopedTimer timer( Stage::DSSIM );
     reset();
     ImageDSSIM dssim;
 
@@ -92,6 +95,30 @@ ImageDSSIM::ImageDSSIM( const ImageCollection & imageCollection1, const ImageCol
     }
 }
 
+ImageDSSIM::ImageDSSIM( const ImageStatistics & statistics, StatisticsPrecision::VALUE precision )
+: m_averaging( statistics.getAveraging() )
+, m_pixelFormat( PixelFormat::UNKNOWN )
+, m_colorspace( Colorspace::UNKNOWN  )
+, m_bitsPerPixelAndChannel( BitsPerPixelAndChannel::UNKNOWN )
+, m_chrominanceSubsampling( ChrominanceSubsampling::UNKNOWN )
+, m_imageBuffer()
+, m_width( 0 )
+, m_height( 0 )
+, m_dssim( 0.0 )
+, m_dssimPeak( 0.0 )
+, m_dssimValid( false )
+{
+    ScopedTimer timer( Stage::DSSIM );
+    reset();
+    ImageDSSIM dssim = calcDSSIM( statistics, precision );
+
+    m_width                  = dssim.m_width;
+    m_height                 = dssim.m_height;
+    m_dssim                  = dssim.m_dssim;
+    m_dssimPeak              = dssim.m_dssimPeak;
+    m_dssimValid             = dssim.m_dssimValid;
+}
+
 void ImageDSSIM::reset()
 {
     m_pixelFormat = PixelFormat::UNKNOWN;
@@ -237,6 +264,19 @@ ImageDSSIM ImageDSSIM::calcDSSIMImage_RGB( const ImageCollection & imageCollecti
         return ret;
     }
 
+    // variance and covariance are not quantized to 8 bit
+    if(    ( image1Variance->getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_32 )
+        || ( image2Variance->getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_32 )
+        || ( covariance.getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_32 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "variance or covariance is not a float image" );
+#endif //USE_LOG4CXX
+        ret.reset();
+        return ret;
+    }
+
     // check sizes
     if(    ( covariance.getWidth() != image1Average->getWidth() )
         || ( covariance.getHeight() != image1Average->getHeight() )
@@ -264,13 +304,19 @@ ImageDSSIM ImageDSSIM::calcDSSIMImage_RGB( const ImageCollection & imageCollecti
     const int width  = image1Average->getWidth();
     const int height = image1Average->getHeight();
 
-    ImageBufferShrdPtr newImageBuffer = std::make_shared<ImageBuffer>( bufferSize );
+    ImageBufferShrdPtr newImageBuffer = BufferPool::getInstance().getBuffer( bufferSize );
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerTransformation, "calculate SSIM ..." );
 #endif //USE_LOG4CXX
 
     const int bytesPerLine = width * bytesPerPixel;
+
+    // variance and covariance are float per channel; the offsets count channels
+    const float * const variance1Plane  = reinterpret_cast<const float *>( image1VarianceBuffer->image );
+    const float * const variance2Plane  = reinterpret_cast<const float *>( image2VarianceBuffer->image );
+    const float * const covariancePlane = reinterpret_cast<const float *>( covarianceBuffer->image );
+
     double dssimSum = 0.0;
     double dssimPeak = -1.0;
 
@@ -287,12 +333,12 @@ ImageDSSIM ImageDSSIM::calcDSSIMImage_RGB( const ImageCollection & imageCollecti
 
 
             const double averaging1Pixel = image1AverageBuffer->image[ xByteOffset + yByteOffset + 0 ] / ssimL;
-            const double variance1Pixel  = image1VarianceBuffer->image[ xByteOffset + yByteOffset + 0 ] / ssimL;
+            const double variance1Pixel  = variance1Plane[ xByteOffset + yByteOffset + 0 ] / ssimL;
 
             const double averaging2Pixel = image2AverageBuffer->image[ xByteOffset + yByteOffset + 0 ] / ssimL;
-            const double variance2Pixel  = image2VarianceBuffer->image[ xByteOffset + yByteOffset + 0 ] / ssimL;
+            const double variance2Pixel  = variance2Plane[ xByteOffset + yByteOffset + 0 ] / ssimL;
 
-            const double covariancePixel = covarianceBuffer->image[ xByteOffset + yByteOffset + 0 ] / ssimL;
+            const double covariancePixel = covariancePlane[ xByteOffset + yByteOffset + 0 ] / ssimL;
 
             const double ssim = ( ( 2.0 * averaging1Pixel * averaging2Pixel + ssimC1 ) * ( 2.0 * covariancePixel + ssimC2 ) )
                                 /
@@ -468,6 +514,19 @@ ImageDSSIM ImageDSSIM::calcDSSIMImage_YUV( const ImageCollection & imageCollecti
         ret.reset();
         return ret;
     }
+
+    // variance and covariance are not quantized to 8 bit
+    if(    ( image1Variance->getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_32 )
+        || ( image2Variance->getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_32 )
+        || ( covariance.getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_32 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "variance or covariance is not a float image" );
+#endif //USE_LOG4CXX
+        ret.reset();
+        return ret;
+    }
     
     // constants for SSIM
     const double ssimL  = 255;   // 2**(#bits per pixel) - 1
@@ -484,7 +543,7 @@ ImageDSSIM ImageDSSIM::calcDSSIMImage_YUV( const ImageCollection & imageCollecti
 
     PlanarImageDesc planaImageNew = calcPlanaerImageDescForYUV( width, height, cs, TJ_PAD );
 
-    ImageBufferShrdPtr imageBufferNew = std::make_shared<ImageBuffer>( planaImageNew.bufferSize );
+    ImageBufferShrdPtr imageBufferNew = BufferPool::getInstance().getBuffer( planaImageNew.bufferSize );
 
     if(    ( !imageBufferNew )
         // || ( !imageBufferOld )
@@ -526,15 +585,15 @@ ImageDSSIM ImageDSSIM::calcDSSIMImage_YUV( const ImageCollection & imageCollecti
 //    const unsigned char * const plane1Image2Average = &image2AverageBuffer->image[ planaImageNew.planeSize0 ];
 //    const unsigned char * const plane2Image2Average = &image2AverageBuffer->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
 
-    const unsigned char * const plane0Image1Variance = &image1VarianceBuffer->image[ 0 ];
+    const float * const plane0Image1Variance = reinterpret_cast<const float *>( image1VarianceBuffer->image );
 //    const unsigned char * const plane1Image1Variance = &image1VarianceBuffer->image[ planaImageNew.planeSize0 ];
 //    const unsigned char * const plane2Image1Variance = &image1VarianceBuffer->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
 
-    const unsigned char * const plane0Image2Variance = &image2VarianceBuffer->image[ 0 ];
+    const float * const plane0Image2Variance = reinterpret_cast<const float *>( image2VarianceBuffer->image );
 //    const unsigned char * const plane1Image2Variance = &image2VarianceBuffer->image[ planaImageNew.planeSize0 ];
 //    const unsigned char * const plane2Image2Variance = &image2VarianceBuffer->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
 
-    const unsigned char * const plane0Covariance = &covarianceBuffer->image[ 0 ];
+    const float * const plane0Covariance = reinterpret_cast<const float *>( covarianceBuffer->image );
 //    const unsigned char * const plane1Covariance = &covarianceBuffer->image[ planaImageNew.planeSize0 ];
 //    const unsigned char * const plane2Covariance = &covarianceBuffer->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
 
@@ -609,6 +668,62 @@ ImageDSSIM ImageDSSIM::calcDSSIMImage_YUV( const ImageCollection & imageCollecti
     return ret;
 }
 
+ImageDSSIM ImageDSSIM::calcDSSIM( const ImageStatistics & statistics, StatisticsPrecision::VALUE precision )
+{
+    ImageDSSIM ret;
+
+    if( !statistics.isValid() )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "statistics are not valid" );
+#endif //USE_LOG4CXX
+        ret.reset();
+        return ret;
+    }
+
+    const int width  = statistics.getWidth();
+    const int height = statistics.getHeight();
+    const int64_t nofPixels = statistics.getNofPixelsPerChunk();
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate SSIM ..." );
+#endif //USE_LOG4CXX
+
+    double dssimSum = 0.0;
+    double dssimPeak = -1.0;
+
+    #pragma omp parallel for reduction(+:dssimSum) reduction(max:dssimPeak)
+    for( int y = 0; y < height; ++y )
+    {
+        double dssimLineSum = 0.0;
+
+        for( int x = 0; x < width; ++x )
+        {
+            const double dssim = calcChunkDSSIM( statistics.getChunk( x, y ), nofPixels, precision );
+
+            dssimLineSum += dssim;
+
+            if( dssim > dssimPeak )
+                dssimPeak = dssim;
+        }
+
+        dssimSum += ( dssimLineSum / static_cast<double>(width) );
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate SSIM ... done" );
+#endif //USE_LOG4CXX
+
+    // collect data
+    ret.m_width      = width;
+    ret.m_height     = height;
+    ret.m_dssim      = dssimSum / static_cast<double>(height);
+    ret.m_dssimPeak  = dssimPeak;
+    ret.m_dssimValid = true;
+
+    return ret;
+}
+
 double ImageDSSIM::getDssim()
 {
     if( !m_dssimValid )
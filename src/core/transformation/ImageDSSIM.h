@@ -4,10 +4,14 @@
 
 // include system headers
 #include <memory> // for smart pointer
+#include <cmath>
+#include <cstdint>
 
 // include application headers
 #include "ImageInterface.h"
 #include "ImageCollection.h"
+#include "ImageStatistics.h"
+#include "enumStatisticsPrecision.h"
 
 namespace imageshrink
 {
@@ -29,6 +33,9 @@ class ImageDSSIM
     public:
         ImageDSSIM();
         ImageDSSIM( const ImageCollection & imageCollection1, const ImageCollection & imageCollection2, int averaging );
+
+        // determines the DSSIM values only; no DSSIM image is created
+        ImageDSSIM( const ImageStatistics & statistics, StatisticsPrecision::VALUE precision = StatisticsPrecision::BITS_8 );
         virtual ~ImageDSSIM() {}
 
     protected:
@@ -73,12 +80,92 @@ class ImageDSSIM
         double getDssim();
         double getDssimPeak();
 
+        // DSSIM of one chunk (or window) from its sums; uses the same 8 bit
+        // quantities ImageAverage, ImageVariance and ImageCovariance deliver
+        static inline double calcChunkDSSIM( const ChunkStatistics & chunk, int64_t nofPixels )
+        {
+            // constants for SSIM
+            static const double ssimL  = 255;   // 2**(#bits per pixel) - 1
+            static const double ssimK1 = 0.01;
+            static const double ssimK2 = 0.03;
+            static const double ssimC1 = pow( ssimK1 * ssimL, 2.0 );
+            static const double ssimC2 = pow( ssimK2 * ssimL, 2.0 );
+
+            const int64_t average1 = chunk.sum1 / nofPixels;
+            const int64_t average2 = chunk.sum2 / nofPixels;
+
+            const int64_t variance1  = ( chunk.sumOfSquares1 - 2 * average1 * chunk.sum1 + nofPixels * average1 * average1 ) / nofPixels;
+            const int64_t variance2  = ( chunk.sumOfSquares2 - 2 * average2 * chunk.sum2 + nofPixels * average2 * average2 ) / nofPixels;
+            const int64_t covariance = ( chunk.sumOfProducts - average2 * chunk.sum1 - average1 * chunk.sum2 + nofPixels * average1 * average2 ) / nofPixels;
+
+            const double averaging1Pixel = static_cast<unsigned char>( average1 ) / ssimL;
+            const double variance1Pixel  = static_cast<unsigned char>( variance1 ) / ssimL;
+
+            const double averaging2Pixel = static_cast<unsigned char>( average2 ) / ssimL;
+            const double variance2Pixel  = static_cast<unsigned char>( variance2 ) / ssimL;
+
+            const double covariancePixel = static_cast<unsigned char>( covariance ) / ssimL;
+
+            const double ssim = ( ( 2.0 * averaging1Pixel * averaging2Pixel + ssimC1 ) * ( 2.0 * covariancePixel + ssimC2 ) )
+                                /
+                                ( ( averaging1Pixel * averaging1Pixel + averaging2Pixel * averaging2Pixel + ssimC1 ) * ( variance1Pixel + variance2Pixel + ssimC2 ) );
+
+            return ( 1.0 - ssim ) / 2.0;
+        }
+
+        // the same without the 8 bit quantities: average, variance and
+        // covariance keep their fractions and are neither clipped nor wrapped
+        static inline double calcChunkDSSIMPrecise( const ChunkStatistics & chunk, int64_t nofPixels )
+        {
+            // constants for SSIM
+            static const double ssimL  = 255;   // 2**(#bits per pixel) - 1
+            static const double ssimK1 = 0.01;
+            static const double ssimK2 = 0.03;
+            static const double ssimC1 = pow( ssimK1 * ssimL, 2.0 );
+            static const double ssimC2 = pow( ssimK2 * ssimL, 2.0 );
+
+            const double n = static_cast<double>( nofPixels );
+
+            const double average1 = chunk.sum1 / n;
+            const double average2 = chunk.sum2 / n;
+
+            // the sums are exact; so the variances cannot get negative
+            const double variance1  = ( chunk.sumOfSquares1 - chunk.sum1 * average1 ) / n;
+            const double variance2  = ( chunk.sumOfSquares2 - chunk.sum2 * average2 ) / n;
+            const double covariance = ( chunk.sumOfProducts - chunk.sum1 * average2 ) / n;
+
+            const double averaging1Pixel = average1 / ssimL;
+            const double variance1Pixel  = variance1 / ssimL;
+
+            const double averaging2Pixel = average2 / ssimL;
+            const double variance2Pixel  = variance2 / ssimL;
+
+            const double covariancePixel = covariance / ssimL;
+
+            const double ssim = ( ( 2.0 * averaging1Pixel * averaging2Pixel + ssimC1 ) * ( 2.0 * covariancePixel + ssimC2 ) )
+                                /
+                                ( ( averaging1Pixel * averaging1Pixel + averaging2Pixel * averaging2Pixel + ssimC1 ) * ( variance1Pixel + variance2Pixel + ssimC2 ) );
+
+            return ( 1.0 - ssim ) / 2.0;
+        }
+
+        static inline double calcChunkDSSIM( const ChunkStatistics & chunk, int64_t nofPixels, StatisticsPrecision::VALUE precision )
+        {
+            if( precision == StatisticsPrecision::FLOAT )
+            {
+                return calcChunkDSSIMPrecise( chunk, nofPixels );
+            }
+
+            return calcChunkDSSIM( chunk, nofPixels );
+        }
+
     protected:
 
     private:
 
         ImageDSSIM calcDSSIMImage_RGB( const ImageCollection & imageCollection1, const ImageCollection & imageCollection2 );
         ImageDSSIM calcDSSIMImage_YUV( const ImageCollection & imageCollection1, const ImageCollection & imageCollection2 );
+        ImageDSSIM calcDSSIM( const ImageStatistics & statistics, StatisticsPrecision::VALUE precision );
 
 }; //class
 
@@ -0,0 +1,288 @@
+
+// include system headers
+#include <algorithm>    // std::max
+
+// include own headers
+#include "ImageReferenceContext.h"
+
+// include application headers
+#include "PlanarImageCalc.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+#endif //USE_LOG4CXX
+
+ImageReferenceContext::ImageReferenceContext()
+: m_pixelFormat( PixelFormat::UNKNOWN )
+, m_colorspace( Colorspace::UNKNOWN )
+, m_chrominanceSubsampling( ChrominanceSubsampling::UNKNOWN )
+, m_width( 0 )
+, m_height( 0 )
+, m_averaging( 8 )
+, m_planeIndex( 0 )
+, m_planeLayout()
+, m_chunkWidth( 0 )
+, m_chunkHeight( 0 )
+, m_widthInChunks( 0 )
+, m_heightInChunks( 0 )
+, m_planeBuffer()
+, m_plane( nullptr )
+, m_planeStride( 0 )
+, m_chunks()
+{
+    reset();
+}
+
+ImageReferenceContext::ImageReferenceContext( const ImageInterface & image, int averaging, int planeIndex )
+: m_pixelFormat( PixelFormat::UNKNOWN )
+, m_colorspace( Colorspace::UNKNOWN )
+, m_chrominanceSubsampling( ChrominanceSubsampling::UNKNOWN )
+, m_width( 0 )
+, m_height( 0 )
+, m_averaging( averaging )
+, m_planeIndex( planeIndex )
+, m_planeLayout()
+, m_chunkWidth( 0 )
+, m_chunkHeight( 0 )
+, m_widthInChunks( 0 )
+, m_heightInChunks( 0 )
+, m_planeBuffer()
+, m_plane( nullptr )
+, m_planeStride( 0 )
+, m_chunks()
+{
+    calcContext( image );
+}
+
+void ImageReferenceContext::reset()
+{
+    m_pixelFormat = PixelFormat::UNKNOWN;
+    m_colorspace = Colorspace::UNKNOWN;
+    m_chrominanceSubsampling = ChrominanceSubsampling::UNKNOWN;
+    m_width = 0;
+    m_height = 0;
+    m_chunkWidth = 0;
+    m_chunkHeight = 0;
+    m_widthInChunks = 0;
+    m_heightInChunks = 0;
+    m_planeBuffer.reset();
+    m_plane = nullptr;
+    m_planeStride = 0;
+    m_chunks.clear();
+}
+
+bool ImageReferenceContext::getPlaneLayout( const ImageInterface & image, int planeIndex, PlaneLayout & layout )
+{
+    if(    ( planeIndex < 0 )
+        || ( planeIndex > 2 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "invalid plane " << planeIndex );
+#endif //USE_LOG4CXX
+        return false;
+    }
+
+    switch( image.getPixelFormat() )
+    {
+        case PixelFormat::RGB:
+            // the planes are the interleaved channels
+            layout.offset        = planeIndex;
+            layout.bytesPerPixel = 3;
+            layout.bytesPerLine  = 3 * image.getWidth();
+            layout.width         = image.getWidth();
+            layout.height        = image.getHeight();
+            layout.subsamplingX  = 1;
+            layout.subsamplingY  = 1;
+            return true;
+
+        case PixelFormat::YCbCr_Planar:
+        {
+            const ChrominanceSubsampling::VALUE cs = image.getChrominanceSubsampling();
+
+            if(    ( planeIndex > 0 )
+                && ( cs == ChrominanceSubsampling::Gray )
+              )
+            {
+#ifdef USE_LOG4CXX
+                LOG4CXX_ERROR( loggerTransformation, "gray image has no chroma planes" );
+#endif //USE_LOG4CXX
+                return false;
+            }
+
+            const PlanarImageDesc desc = calcPlanaerImageDescForYUV( image.getWidth(), image.getHeight(), cs, TJ_PAD );
+
+            layout.bytesPerPixel = 1;
+
+            if( planeIndex == 0 )
+            {
+                layout.offset       = 0;
+                layout.bytesPerLine = desc.stride0;
+                layout.width        = image.getWidth();    // without the padding of the subsampling
+                layout.height       = image.getHeight();
+                layout.subsamplingX = 1;
+                layout.subsamplingY = 1;
+            }
+            else
+            {
+                layout.offset       = ( planeIndex == 1 ) ? desc.planeSize0 : desc.planeSize0 + desc.planeSize1;
+                layout.bytesPerLine = ( planeIndex == 1 ) ? desc.stride1 : desc.stride2;
+                layout.width        = ( planeIndex == 1 ) ? desc.width1 : desc.width2;
+                layout.height       = ( planeIndex == 1 ) ? desc.height1 : desc.height2;
+                calcChromaSubsamplingFactors( cs, layout.subsamplingX, layout.subsamplingY );
+            }
+
+            return true;
+        }
+
+        default:
+#ifdef USE_LOG4CXX
+            LOG4CXX_ERROR( loggerTransformation, "unknown pixelformat " << PixelFormat::toString( image.getPixelFormat() ) );
+#endif //USE_LOG4CXX
+            return false;
+    }
+}
+
+bool ImageReferenceContext::getFirstPlaneLayout( const ImageInterface & image, int & bytesPerPixel, int & bytesPerLine )
+{
+    PlaneLayout layout;
+
+    if( !getPlaneLayout( image, 0, layout ) )
+    {
+        return false;
+    }
+
+    bytesPerPixel = layout.bytesPerPixel;
+    bytesPerLine  = layout.bytesPerLine;
+
+    return true;
+}
+
+void ImageReferenceContext::calcContext( const ImageInterface & image )
+{
+    ImageBufferShrdPtr imageBuffer = image.getImageBuffer();
+
+    if( !imageBuffer )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "imageBuffer is a nullptr" );
+#endif //USE_LOG4CXX
+        reset();
+        return;
+    }
+
+    if( image.getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_8 )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "unsupported bits per pixel and channel" );
+#endif //USE_LOG4CXX
+        reset();
+        return;
+    }
+
+    if( !getPlaneLayout( image, m_planeIndex, m_planeLayout ) )
+    {
+        reset();
+        return;
+    }
+
+    m_pixelFormat            = image.getPixelFormat();
+    m_colorspace             = image.getColorspace();
+    m_chrominanceSubsampling = image.getChrominanceSubsampling();
+    m_width                  = image.getWidth();
+    m_height                 = image.getHeight();
+
+    // incomplete chunks at the right and bottom border are ignored (like ImageAverage)
+    m_chunkWidth     = std::max( m_averaging / m_planeLayout.subsamplingX, 1 );
+    m_chunkHeight    = std::max( m_averaging / m_planeLayout.subsamplingY, 1 );
+    m_widthInChunks  = m_planeLayout.width / m_chunkWidth;
+    m_heightInChunks = m_planeLayout.height / m_chunkHeight;
+
+    if(    ( m_widthInChunks <= 0 )
+        || ( m_heightInChunks <= 0 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "image is smaller than one chunk" );
+#endif //USE_LOG4CXX
+        reset();
+        return;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate reference context ..." );
+#endif //USE_LOG4CXX
+
+    // dense copy of the plane; every line starts at an aligned address
+    const int planeWidth    = m_planeLayout.width;
+    const int planeHeight   = m_planeLayout.height;
+    const int bytesPerPixel = m_planeLayout.bytesPerPixel;
+    const int bytesPerLine  = m_planeLayout.bytesPerLine;
+
+    m_planeStride = ( ( planeWidth + planeAlignment - 1 ) / planeAlignment ) * planeAlignment;
+    m_planeBuffer = std::make_shared<ImageBuffer>( m_planeStride * planeHeight );
+
+    unsigned char * const plane = m_planeBuffer->image;
+    m_plane = plane;
+
+    const unsigned char * const source = &imageBuffer->image[ m_planeLayout.offset ];
+
+    #pragma omp parallel for
+    for( int y = 0; y < planeHeight; ++y )
+    {
+        const unsigned char * const sourceLine = &source[ y * bytesPerLine ];
+        unsigned char * const planeLine = &plane[ y * m_planeStride ];
+
+        for( int x = 0; x < planeWidth; ++x )
+        {
+            planeLine[x] = sourceLine[ x * bytesPerPixel ];
+        }
+    }
+
+    // sums of the reference; a line segment of a chunk fits into 32 bit
+    m_chunks.assign( m_widthInChunks * m_heightInChunks, ReferenceChunk() );
+
+    #pragma omp parallel for
+    for( int yChunk = 0; yChunk < m_heightInChunks; ++yChunk )
+    {
+        ReferenceChunk * const chunkLine = &m_chunks[ yChunk * m_widthInChunks ];
+
+        for( int yOffset = 0; yOffset < m_chunkHeight; ++yOffset )
+        {
+            const unsigned char * const line = getPlaneLine( yChunk * m_chunkHeight + yOffset );
+
+            for( int xChunk = 0; xChunk < m_widthInChunks; ++xChunk )
+            {
+                const unsigned char * const segment = &line[ xChunk * m_chunkWidth ];
+
+                int sum = 0;
+                int sumOfSquares = 0;
+
+                for( int x = 0; x < m_chunkWidth; ++x )
+                {
+                    const int value = segment[x];
+
+                    sum          += value;
+                    sumOfSquares += value * value;
+                }
+
+                chunkLine[ xChunk ].sum          += sum;
+                chunkLine[ xChunk ].sumOfSquares += sumOfSquares;
+            }
+        }
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate reference context ... done" );
+#endif //USE_LOG4CXX
+}
+
+} //namespace imageshrink
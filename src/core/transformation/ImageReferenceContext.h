@@ -0,0 +1,125 @@
+
+#ifndef IMAGEREFERENCECONTEXT_H_
+#define IMAGEREFERENCECONTEXT_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+#include <cstdint>
+
+// include application headers
+#include "ImageInterface.h"
+#include "ImageBuffer.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class ImageReferenceContext;
+typedef std::shared_ptr<ImageReferenceContext> ImageReferenceContextShrdPtr;
+typedef std::weak_ptr<ImageReferenceContext>   ImageReferenceContextWkPtr;
+
+// sums over the pixels of one chunk of the reference image
+struct ReferenceChunk
+{
+    int64_t sum;
+    int64_t sumOfSquares;
+};
+
+// byte layout of one plane (Y/Cb/Cr resp. R/G/B) of an image
+struct PlaneLayout
+{
+    int offset;          // of the first pixel in the image buffer
+    int bytesPerPixel;
+    int bytesPerLine;
+    int width;           // in pixels of the plane
+    int height;
+    int subsamplingX;    // image pixels per plane pixel
+    int subsamplingY;
+};
+
+// declaration
+// everything about one plane of the original image the DSSIM needs; it is
+// determined once and shared by all candidates of the quality search.
+// The chunks of a subsampled plane cover the same image area as the chunks
+// of the first plane.
+class ImageReferenceContext
+: public std::enable_shared_from_this<ImageReferenceContext>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        ImageReferenceContext();
+        ImageReferenceContext( const ImageInterface & image, int averaging, int planeIndex = 0 );
+        virtual ~ImageReferenceContext() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+        static const int planeAlignment = ImageBuffer::alignment;   // bytes
+
+    protected:
+
+    private:
+        PixelFormat::VALUE            m_pixelFormat;
+        Colorspace::VALUE             m_colorspace;
+        ChrominanceSubsampling::VALUE m_chrominanceSubsampling;
+        int                           m_width;          // in pixels of the image
+        int                           m_height;         // in pixels of the image
+        int                           m_averaging;      // in pixels of the image
+        int                           m_planeIndex;
+        PlaneLayout                   m_planeLayout;
+        int                           m_chunkWidth;     // in pixels of the plane
+        int                           m_chunkHeight;    // in pixels of the plane
+        int                           m_widthInChunks;
+        int                           m_heightInChunks;
+
+        ImageBufferShrdPtr            m_planeBuffer;    // owns the plane copy
+        const unsigned char *         m_plane;          // aligned first plane, 1 byte per pixel
+        int                           m_planeStride;    // multiple of planeAlignment
+
+        std::vector<ReferenceChunk>   m_chunks;
+
+    //********** METHODS **********
+    public:
+        PixelFormat::VALUE getPixelFormat() const { return m_pixelFormat; }
+        Colorspace::VALUE getColorspace() const { return m_colorspace; }
+        ChrominanceSubsampling::VALUE getChrominanceSubsampling() const { return m_chrominanceSubsampling; }
+        int getWidth() const { return m_width; }
+        int getHeight() const { return m_height; }
+        int getAveraging() const { return m_averaging; }
+        int getPlaneIndex() const { return m_planeIndex; }
+        const PlaneLayout & getPlaneLayout() const { return m_planeLayout; }
+        int getChunkWidth() const { return m_chunkWidth; }
+        int getChunkHeight() const { return m_chunkHeight; }
+        int getWidthInChunks() const { return m_widthInChunks; }
+        int getHeightInChunks() const { return m_heightInChunks; }
+
+        const unsigned char * getPlaneLine( int y ) const { return &m_plane[ y * m_planeStride ]; }
+        const ReferenceChunk & getChunk( int x, int y ) const { return m_chunks[ y * m_widthInChunks + x ]; }
+
+        bool isValid() const { return !m_chunks.empty(); }
+        void reset();
+
+        // byte layout of one plane of an image; false for unknown formats
+        // and planes the image does not have
+        static bool getPlaneLayout( const ImageInterface & image, int planeIndex, PlaneLayout & layout );
+
+        // byte layout of the first plane (Y resp. R) of an image
+        static bool getFirstPlaneLayout( const ImageInterface & image, int & bytesPerPixel, int & bytesPerLine );
+
+    protected:
+
+    private:
+        void calcContext( const ImageInterface & image );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //IMAGEREFERENCECONTEXT_H_
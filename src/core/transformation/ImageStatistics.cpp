@@ -0,0 +1,264 @@
+
+// include system headers
+// ...
+
+// include own headers
+#include "ImageStatistics.h"
+
+// include application headers
+#include "ScopedTimer.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+#endif //USE_LOG4CXX
+
+ImageStatistics::ImageStatistics()
+: m_averaging( 8 )
+, m_chunkWidth( 0 )
+, m_chunkHeight( 0 )
+, m_width( 0 )
+, m_height( 0 )
+, m_chunks()
+{
+    reset();
+}
+
+ImageStatistics::ImageStatistics( const ImageInterface & image1, const ImageInterface & image2, int averaging )
+: m_averaging( averaging )
+, m_chunkWidth( 0 )
+, m_chunkHeight( 0 )
+, m_width( 0 )
+, m_height( 0 )
+, m_chunks()
+{
+    calcStatistics( ImageReferenceContext( image1, averaging ), image2 );
+}
+
+ImageStatistics::ImageStatistics( const ImageReferenceContext & reference, const ImageInterface & image )
+: m_averaging( reference.getAveraging() )
+, m_chunkWidth( 0 )
+, m_chunkHeight( 0 )
+, m_width( 0 )
+, m_height( 0 )
+, m_chunks()
+{
+    calcStatistics( reference, image );
+}
+
+void ImageStatistics::reset()
+{
+    m_chunkWidth = 0;
+    m_chunkHeight = 0;
+    m_width = 0;
+    m_height = 0;
+    m_chunks.clear();
+}
+
+bool ImageStatistics::prepareStatistics( const ImageReferenceContext & reference, const ImageInterface & image, PlaneLayout & layout )
+{
+    ImageBufferShrdPtr imageBuffer = image.getImageBuffer();
+
+    // check reference and buffer
+    if(    ( !reference.isValid() )
+        || ( !imageBuffer )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "reference context is not valid or imageBuffer is a nullptr" );
+#endif //USE_LOG4CXX
+        reset();
+        return false;
+    }
+
+    // check formats; the chrominance subsampling may differ
+    if(    ( reference.getPixelFormat() != image.getPixelFormat() )
+        || ( reference.getColorspace() != image.getColorspace() )
+        || ( image.getBitsPerPixelAndChannel() != BitsPerPixelAndChannel::BITS_8 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "format mismatch between images (" << __FILE__ << ", " << __LINE__ << ")" );
+#endif //USE_LOG4CXX
+        reset();
+        return false;
+    }
+
+    // check sizes
+    if(    ( reference.getWidth() != image.getWidth() )
+        || ( reference.getHeight() != image.getHeight() )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "size mismatch between images (" << __FILE__ << ", " << __LINE__ << ")" );
+#endif //USE_LOG4CXX
+        reset();
+        return false;
+    }
+
+    if( !ImageReferenceContext::getPlaneLayout( image, reference.getPlaneIndex(), layout ) )
+    {
+        reset();
+        return false;
+    }
+
+    m_averaging   = reference.getAveraging();
+    m_chunkWidth  = reference.getChunkWidth();
+    m_chunkHeight = reference.getChunkHeight();
+    m_width       = reference.getWidthInChunks();
+    m_height      = reference.getHeightInChunks();
+    m_chunks.assign( m_width * m_height, ChunkStatistics() );
+
+    return true;
+}
+
+void ImageStatistics::calcChunkLine( const ImageReferenceContext & reference, const unsigned char * plane, const PlaneLayout & layout, int yChunk )
+{
+    ChunkStatistics * const chunkLine = &m_chunks[ yChunk * m_width ];
+
+    const PlaneLayout & referenceLayout = reference.getPlaneLayout();
+    const int bytesPerPixel = layout.bytesPerPixel;
+    const int bytesPerLine  = layout.bytesPerLine;
+
+    // the candidate is streamed line by line; each line segment of a chunk
+    // fits into 32 bit sums (256 * 255 * 255 < 2^31)
+    for( int yOffset = 0; yOffset < m_chunkHeight; ++yOffset )
+    {
+        const int y = yChunk * m_chunkHeight + yOffset;
+        const int y2 = ( y * referenceLayout.subsamplingY ) / layout.subsamplingY;
+        const unsigned char * const line1 = reference.getPlaneLine( y );
+        const unsigned char * const line2 = &plane[ y2 * bytesPerLine ];
+
+        for( int xChunk = 0; xChunk < m_width; ++xChunk )
+        {
+            const unsigned char * const segment1 = &line1[ xChunk * m_chunkWidth ];
+
+            int sum2 = 0;
+            int sumOfSquares2 = 0;
+            int sumOfProducts = 0;
+
+            if( referenceLayout.subsamplingX == layout.subsamplingX )
+            {
+                const unsigned char * const segment2 = &line2[ xChunk * m_chunkWidth * bytesPerPixel ];
+
+                for( int x = 0; x < m_chunkWidth; ++x )
+                {
+                    const int value1 = segment1[x];
+                    const int value2 = segment2[ x * bytesPerPixel ];
+
+                    sum2          += value2;
+                    sumOfSquares2 += value2 * value2;
+                    sumOfProducts += value1 * value2;
+                }
+            }
+            else
+            {
+                for( int x = 0; x < m_chunkWidth; ++x )
+                {
+                    const int x2 = ( ( xChunk * m_chunkWidth + x ) * referenceLayout.subsamplingX ) / layout.subsamplingX;
+                    const int value1 = segment1[x];
+                    const int value2 = line2[ x2 * bytesPerPixel ];
+
+                    sum2          += value2;
+                    sumOfSquares2 += value2 * value2;
+                    sumOfProducts += value1 * value2;
+                }
+            }
+
+            ChunkStatistics & chunk = chunkLine[ xChunk ];
+            chunk.sum2          += sum2;
+            chunk.sumOfSquares2 += sumOfSquares2;
+            chunk.sumOfProducts += sumOfProducts;
+        }
+    }
+
+    // the sums of the reference are known already
+    for( int xChunk = 0; xChunk < m_width; ++xChunk )
+    {
+        const ReferenceChunk & referenceChunk = reference.getChunk( xChunk, yChunk );
+        chunkLine[ xChunk ].sum1          = referenceChunk.sum;
+        chunkLine[ xChunk ].sumOfSquares1 = referenceChunk.sumOfSquares;
+    }
+}
+
+void ImageStatistics::calcStatistics( const ImageReferenceContext & reference, const ImageInterface & image )
+{
+    ScopedTimer timer( Stage::STATISTICS );
+    PlaneLayout layout;
+
+    if( !prepareStatistics( reference, image, layout ) )
+    {
+        return;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate statistics ..." );
+#endif //USE_LOG4CXX
+
+    const unsigned char * const plane = &image.getImageBuffer()->image[ layout.offset ];
+
+    #pragma omp parallel for
+    for( int yChunk = 0; yChunk < m_height; ++yChunk )
+    {
+        calcChunkLine( reference, plane, layout, yChunk );
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate statistics ... done" );
+#endif //USE_LOG4CXX
+}
+
+std::vector<ImageStatistics> ImageStatistics::calcPlaneStatistics( const std::vector<ImageReferenceContextShrdPtr> & references,
+                                                                   const ImageInterface & image )
+{
+    ScopedTimer timer( Stage::STATISTICS );
+    const int nofPlanes = references.size();
+
+    std::vector<ImageStatistics> ret( nofPlanes );
+    std::vector<PlaneLayout> layouts( nofPlanes );
+    std::vector<const unsigned char *> planes( nofPlanes, nullptr );
+
+    for( int i = 0; i < nofPlanes; ++i )
+    {
+        if(    ( !references[i] )
+            || ( !ret[i].prepareStatistics( *references[i], image, layouts[i] ) )
+          )
+        {
+            return std::vector<ImageStatistics>();
+        }
+
+        planes[i] = &image.getImageBuffer()->image[ layouts[i].offset ];
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate statistics of " << nofPlanes << " planes ..." );
+#endif //USE_LOG4CXX
+
+    // threads done with their lines of one plane continue with the next plane
+    #pragma omp parallel
+    {
+        for( int i = 0; i < nofPlanes; ++i )
+        {
+            #pragma omp for schedule(dynamic, 1) nowait
+            for( int yChunk = 0; yChunk < ret[i].m_height; ++yChunk )
+            {
+                ret[i].calcChunkLine( *references[i], planes[i], layouts[i], yChunk );
+            }
+        }
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate statistics of " << nofPlanes << " planes ... done" );
+#endif //USE_LOG4CXX
+
+    return ret;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,95 @@
+
+#ifndef IMAGESTATISTICS_H_
+#define IMAGESTATISTICS_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+#include <cstdint>
+
+// include application headers
+#include "ImageInterface.h"
+#include "ImageReferenceContext.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class ImageStatistics;
+typedef std::shared_ptr<ImageStatistics> ImageStatisticsShrdPtr;
+typedef std::weak_ptr<ImageStatistics>   ImageStatisticsWkPtr;
+
+// sums over the pixels of one chunk of two images
+struct ChunkStatistics
+{
+    int64_t sum1;
+    int64_t sum2;
+    int64_t sumOfSquares1;
+    int64_t sumOfSquares2;
+    int64_t sumOfProducts;
+};
+
+// declaration
+// per-chunk statistics of one plane of two images (the plane of the
+// reference context); the sums of the reference are taken from its
+// context, so only the candidate and the cross term are computed in a
+// single pass. A candidate plane with another subsampling than the
+// reference is sampled at the positions of the reference pixels.
+class ImageStatistics
+: public std::enable_shared_from_this<ImageStatistics>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        ImageStatistics();
+        ImageStatistics( const ImageInterface & image1, const ImageInterface & image2, int averaging );
+        ImageStatistics( const ImageReferenceContext & reference, const ImageInterface & image );
+        virtual ~ImageStatistics() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        int                          m_averaging;
+        int                          m_chunkWidth;     // in pixels of the plane
+        int                          m_chunkHeight;    // in pixels of the plane
+        int                          m_width;    // in chunks
+        int                          m_height;   // in chunks
+        std::vector<ChunkStatistics> m_chunks;
+
+    //********** METHODS **********
+    public:
+        int getAveraging() const { return m_averaging; }
+        int64_t getNofPixelsPerChunk() const { return static_cast<int64_t>( m_chunkWidth ) * m_chunkHeight; }
+        int getWidth() const { return m_width; }
+        int getHeight() const { return m_height; }
+        const ChunkStatistics & getChunk( int x, int y ) const { return m_chunks[ y * m_width + x ]; }
+        bool isValid() const { return !m_chunks.empty(); }
+        void reset();
+
+        // statistics of several planes; the chunk lines of all planes are
+        // distributed over the threads together, so the small chroma planes
+        // do not run after the luminance
+        static std::vector<ImageStatistics> calcPlaneStatistics( const std::vector<ImageReferenceContextShrdPtr> & references,
+                                                                 const ImageInterface & image );
+
+    protected:
+
+    private:
+        void calcStatistics( const ImageReferenceContext & reference, const ImageInterface & image );
+        bool prepareStatistics( const ImageReferenceContext & reference, const ImageInterface & image, PlaneLayout & layout );
+        void calcChunkLine( const ImageReferenceContext & reference, const unsigned char * plane, const PlaneLayout & layout, int yChunk );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //IMAGESTATISTICS_H_
@@ -7,6 +7,9 @@
 
 // include application headers
 #include "PlanarImageCalc.h"
+#include "BufferPool.h"
+#include "PlaneBands.h"
+#include "ScopedTimer.h"
 
 // include 3rd party headers
 #ifdef USE_LOG4CXX
@@ -43,6 +46,7 @@ ImageVariance::ImageVariance( const ImageInterface & image, const ImageInterface
 , m_width( 0 )
 , m_height( 0 )
 {
+    ScopedTimer timer( Stage::VARIANCE );
     reset();
     ImageVariance var;
 
@@ -139,7 +143,7 @@ ImageVariance ImageVariance::calcVarianceImage_RGB( const ImageInterface & image
     const int nofPixels     = image.getWidth() * image.getHeight();
     const int bufferSize    = bytesPerPixel * nofPixels;
 
-    if( bufferSize != imageBuffer->size )
+    if( static_cast<std::size_t>( bufferSize ) != imageBuffer->size )
     {
 #ifdef USE_LOG4CXX
         LOG4CXX_ERROR( loggerTransformation, "buffer size mismatch (" << __FILE__ << ", " << __LINE__ << ")" );
@@ -165,7 +169,9 @@ ImageVariance ImageVariance::calcVarianceImage_RGB( const ImageInterface & image
     );
 #endif //USE_LOG4CXX
 
-    ImageBufferShrdPtr newImageBuffer = std::make_shared<ImageBuffer>( newBufferSize );
+    // float per channel; the values are neither clipped nor quantized
+    ImageBufferShrdPtr newImageBuffer = BufferPool::getInstance().getBuffer( newBufferSize * sizeof( float ) );
+    float * const newPlanes = reinterpret_cast<float *>( newImageBuffer->image );
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerTransformation, "determine variance ..." );
@@ -209,9 +215,9 @@ ImageVariance ImageVariance::calcVarianceImage_RGB( const ImageInterface & image
             }
 
             const int avgAvg = m_averaging * m_averaging;
-            newImageBuffer->image[ xNewByteOffset + yNewByteOffset + 0 ] = sumCh1 / avgAvg;
-            newImageBuffer->image[ xNewByteOffset + yNewByteOffset + 1 ] = sumCh2 / avgAvg;
-            newImageBuffer->image[ xNewByteOffset + yNewByteOffset + 2 ] = sumCh3 / avgAvg;
+            newPlanes[ xNewByteOffset + yNewByteOffset + 0 ] = static_cast<float>( sumCh1 ) / avgAvg;
+            newPlanes[ xNewByteOffset + yNewByteOffset + 1 ] = static_cast<float>( sumCh2 ) / avgAvg;
+            newPlanes[ xNewByteOffset + yNewByteOffset + 2 ] = static_cast<float>( sumCh3 ) / avgAvg;
         }
     }
 
@@ -222,7 +228,7 @@ ImageVariance ImageVariance::calcVarianceImage_RGB( const ImageInterface & image
     // collect data
     ret.m_pixelFormat            = image.getPixelFormat();
     ret.m_colorspace             = image.getColorspace();
-    ret.m_bitsPerPixelAndChannel = image.getBitsPerPixelAndChannel();
+    ret.m_bitsPerPixelAndChannel = BitsPerPixelAndChannel::BITS_32;
     ret.m_chrominanceSubsampling = image.getChrominanceSubsampling();
     ret.m_imageBuffer            = newImageBuffer;
     ret.m_width                  = newWidth;
@@ -324,7 +330,7 @@ ImageVariance ImageVariance::calcVarianceImage_YUV( const ImageInterface & image
     PlanarImageDesc planaImageNew = calcPlanaerImageDescForYUV( newWidth, newHeight, cs, TJ_PAD );
     PlanarImageDesc planaImageOld = calcPlanaerImageDescForYUV( oldWidth, oldHeight, cs, TJ_PAD );
 
-    ImageBufferShrdPtr imageBufferNew = std::make_shared<ImageBuffer>( planaImageNew.bufferSize );
+    ImageBufferShrdPtr imageBufferNew = BufferPool::getInstance().getBuffer( planaImageNew.bufferSize * sizeof( float ) );
     ImageBufferShrdPtr imageBufferOld = image.getImageBuffer();
     ImageBufferShrdPtr imageAvgBuffer = averageImage.getImageBuffer();
 
@@ -378,141 +384,75 @@ ImageVariance ImageVariance::calcVarianceImage_YUV( const ImageInterface & image
     LOG4CXX_INFO( loggerTransformation, "determine variance ... " );
 #endif //USE_LOG4CXX
 
-    unsigned char * const plane0New = &imageBufferNew->image[ 0 ];
-    unsigned char * const plane1New = &imageBufferNew->image[ planaImageNew.planeSize0 ];
-    unsigned char * const plane2New = &imageBufferNew->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
-
-    const unsigned char * const plane0Old = &imageBufferOld->image[ 0 ];
-    const unsigned char * const plane1Old = &imageBufferOld->image[ planaImageOld.planeSize0 ];
-    const unsigned char * const plane2Old = &imageBufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ];
-
-    const unsigned char * const plane0Avg = &imageAvgBuffer->image[ 0 ];
-    const unsigned char * const plane1Avg = &imageAvgBuffer->image[ planaImageNew.planeSize0 ];
-    const unsigned char * const plane2Avg = &imageAvgBuffer->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ];
-
-    // determine new image
-    #pragma omp parallel sections
+    // float per sample; the values are neither clipped nor quantized
+    float * const planeNew0 = reinterpret_cast<float *>( imageBufferNew->image );
+    float * const planesNew[3] = { &planeNew0[ 0 ],
+                                   &planeNew0[ planaImageNew.planeSize0 ],
+                                   &planeNew0[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ] };
+
+    const unsigned char * const planesOld[3] = { &imageBufferOld->image[ 0 ],
+                                                 &imageBufferOld->image[ planaImageOld.planeSize0 ],
+                                                 &imageBufferOld->image[ planaImageOld.planeSize0 + planaImageOld.planeSize1 ] };
+
+    const unsigned char * const planesAvg[3] = { &imageAvgBuffer->image[ 0 ],
+                                                 &imageAvgBuffer->image[ planaImageNew.planeSize0 ],
+                                                 &imageAvgBuffer->image[ planaImageNew.planeSize0 + planaImageNew.planeSize1 ] };
+
+    const int stridesNew[3] = { planaImageNew.stride0, planaImageNew.stride1, planaImageNew.stride2 };
+    const int stridesOld[3] = { planaImageOld.stride0, planaImageOld.stride1, planaImageOld.stride2 };
+    const int widthsNew[3]  = { planaImageNew.width0, planaImageNew.width1, planaImageNew.width2 };
+    const int heightsNew[3] = { planaImageNew.height0, planaImageNew.height1, planaImageNew.height2 };
+    const int averagingX[3] = { m_averaging, chromaAveragingX, chromaAveragingX };
+    const int averagingY[3] = { m_averaging, chromaAveragingY, chromaAveragingY };
+
+    // a new line costs all old pixels of its chunks
+    const int costPerLine[3] = { widthsNew[0] * averagingX[0] * averagingY[0],
+                                 widthsNew[1] * averagingX[1] * averagingY[1],
+                                 widthsNew[2] * averagingX[2] * averagingY[2] };
+
+    // determine new image; the lines of all planes are distributed over the threads together
+    runPlaneBands( calcPlaneBands( costPerLine, heightsNew, 3 ), [&]( int plane, int yBegin, int yEnd )
     {
-        // create chroma plane
-        #pragma omp section
+        const int bytesPerPixel = 1;
+        const int bytesPerNewLine = stridesNew[ plane ];
+        const int bytesPerOldLine = stridesOld[ plane ];
+        const int averagingPlaneX = averagingX[ plane ];
+        const int averagingPlaneY = averagingY[ plane ];
+        float * const planeNew = planesNew[ plane ];
+        const unsigned char * const planeOld = planesOld[ plane ];
+        const unsigned char * const planeAvg = planesAvg[ plane ];
+
+        for( int yNew = yBegin; yNew < yEnd; ++yNew )
         {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride0;
-            const int bytesPerOldLine = planaImageOld.stride0;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height0; ++yNew )
+            for( int xNew = 0; xNew < widthsNew[ plane ]; ++xNew )
             {
-                for( int xNew = 0; xNew < planaImageNew.width0; ++xNew )
-                {
-                    int sum = 0;
-
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
-
-                    for( int yOldOffset = 0; yOldOffset < m_averaging; ++yOldOffset )
-                    {
-                        const int yOld = yNew * m_averaging + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < m_averaging; ++xOldOffset )
-                        {
-                            const int xOld = xNew * m_averaging + xOldOffset;
+                int sum = 0;
 
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
+                const int xNewByteOffset = bytesPerPixel * xNew;
+                const int yNewByteOffset = bytesPerNewLine * yNew;
 
-                            int value  = plane0Old[ xOldByteOffset + yOldByteOffset ];
-                            value     -= plane0Avg[ xNewByteOffset + yNewByteOffset ];
-                            sum       += ( value * value );
-                        }
-                    }
-
-                    const int avgAvg = m_averaging * m_averaging;
-                    plane0New[ xNewByteOffset + yNewByteOffset ] = sum / avgAvg;
-                }
-            }
-        }
-
-        // create U/Cb plane
-        #pragma omp section
-        {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride1;
-            const int bytesPerOldLine = planaImageOld.stride1;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height1; ++yNew )
-            {
-                for( int xNew = 0; xNew < planaImageNew.width1; ++xNew )
+                for( int yOldOffset = 0; yOldOffset < averagingPlaneY; ++yOldOffset )
                 {
-                    int sum = 0;
+                    const int yOld = yNew * averagingPlaneY + yOldOffset;
 
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
-
-                    for( int yOldOffset = 0; yOldOffset < chromaAveragingY; ++yOldOffset )
+                    for( int xOldOffset = 0; xOldOffset < averagingPlaneX; ++xOldOffset )
                     {
-                        const int yOld = yNew * chromaAveragingY + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < chromaAveragingX; ++xOldOffset )
-                        {
-                            const int xOld = xNew * chromaAveragingX + xOldOffset;
+                        const int xOld = xNew * averagingPlaneX + xOldOffset;
 
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
+                        const int xOldByteOffset = bytesPerPixel * xOld;
+                        const int yOldByteOffset = bytesPerOldLine * yOld;
 
-                            int value  = plane1Old[ xOldByteOffset + yOldByteOffset ];
-                            value     -= plane1Avg[ xNewByteOffset + yNewByteOffset ];
-                            sum       += ( value * value );
-                        }
+                        int value  = planeOld[ xOldByteOffset + yOldByteOffset ];
+                        value     -= planeAvg[ xNewByteOffset + yNewByteOffset ];
+                        sum       += ( value * value );
                     }
-
-                    const int avgAvg = chromaAveragingX * chromaAveragingY;
-                    plane1New[ xNewByteOffset + yNewByteOffset ] = sum / avgAvg;
                 }
-            }
-        }
-
-        // create V/Cr plane
-        #pragma omp section
-        {
-            const int bytesPerPixel = 1;
-            const int bytesPerNewLine = planaImageNew.stride2;
-            const int bytesPerOldLine = planaImageOld.stride2;
-
-            #pragma omp parallel for
-            for( int yNew = 0; yNew < planaImageNew.height2; ++yNew )
-            {
-                for( int xNew = 0; xNew < planaImageNew.width2; ++xNew )
-                {
-                    int sum = 0;
 
-                    const int xNewByteOffset = bytesPerPixel * xNew;
-                    const int yNewByteOffset = bytesPerNewLine * yNew;
-
-                    for( int yOldOffset = 0; yOldOffset < chromaAveragingY; ++yOldOffset )
-                    {
-                        const int yOld = yNew * chromaAveragingY + yOldOffset;
-
-                        for( int xOldOffset = 0; xOldOffset < chromaAveragingX; ++xOldOffset )
-                        {
-                            const int xOld = xNew * chromaAveragingX + xOldOffset;
-
-                            const int xOldByteOffset = bytesPerPixel * xOld;
-                            const int yOldByteOffset = bytesPerOldLine * yOld;
-
-                            int value  = plane2Old[ xOldByteOffset + yOldByteOffset ];
-                            value     -= plane2Avg[ xNewByteOffset + yNewByteOffset ];
-                            sum       += ( value * value );
-                        }
-                    }
-
-                    const int avgAvg = chromaAveragingX * chromaAveragingY;
-                    plane2New[ xNewByteOffset + yNewByteOffset ] = sum / avgAvg;
-                }
+                const int avgAvg = averagingPlaneX * averagingPlaneY;
+                planeNew[ xNewByteOffset + yNewByteOffset ] = static_cast<float>( sum ) / avgAvg;
             }
         }
-    }
+    } );
 
 #ifdef USE_LOG4CXX
     LOG4CXX_INFO( loggerTransformation, "determine variance ... done" );
@@ -521,7 +461,7 @@ ImageVariance ImageVariance::calcVarianceImage_YUV( const ImageInterface & image
     // collect information
     ret.m_pixelFormat = image.getPixelFormat();
     ret.m_colorspace = image.getColorspace();
-    ret.m_bitsPerPixelAndChannel = image.getBitsPerPixelAndChannel();
+    ret.m_bitsPerPixelAndChannel = BitsPerPixelAndChannel::BITS_32;
     ret.m_chrominanceSubsampling = cs;
     ret.m_imageBuffer = imageBufferNew;
     ret.m_width = newWidth;
@@ -0,0 +1,224 @@
+
+// include system headers
+#include <algorithm>    // std::max
+#include <cmath>
+
+// include own headers
+#include "MultiScaleSSIM.h"
+
+// include application headers
+#include "ImageAverage.h"
+#include "ImageStatistics.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+#endif //USE_LOG4CXX
+
+// exponents of the scales from Wang et al. (finest scale first)
+static const double scaleWeights[ MultiScaleSSIM::maxNofScales ] = { 0.0448, 0.2856, 0.3001, 0.2363, 0.1333 };
+
+MultiScaleSSIM::MultiScaleSSIM( const ImageInterface & original, int averaging )
+: m_averaging( averaging )
+, m_widthInChunks( 0 )
+, m_heightInChunks( 0 )
+, m_nofScales( 0 )
+, m_references()
+{
+    // the coarsest scale needs at least one window
+    while(    ( m_nofScales < maxNofScales )
+           && ( ( original.getWidth() >> m_nofScales ) >= windowSize )
+           && ( ( original.getHeight() >> m_nofScales ) >= windowSize )
+         )
+    {
+        m_nofScales++;
+    }
+
+    if( m_nofScales == 0 )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "image is smaller than one window" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+    // the exponents of the scales used sum up to 1
+    double weightSum = 0.0;
+
+    for( int scale = 0; scale < m_nofScales; ++scale )
+    {
+        weightSum += scaleWeights[ scale ];
+    }
+
+    for( int scale = 0; scale < m_nofScales; ++scale )
+    {
+        m_weights[ scale ] = scaleWeights[ scale ] / weightSum;
+    }
+
+    m_widthInChunks  = original.getWidth() / m_averaging;
+    m_heightInChunks = original.getHeight() / m_averaging;
+
+    // the contexts keep a copy of the plane; the pyramid itself is dropped
+    m_references.push_back( std::make_shared<ImageReferenceContext>( original, windowSize ) );
+
+    ImageAverage level;
+
+    for( int scale = 1; scale < m_nofScales; ++scale )
+    {
+        level = ( scale == 1 ) ? ImageAverage( original, 2 ) : ImageAverage( level, 2 );
+        m_references.push_back( std::make_shared<ImageReferenceContext>( level, windowSize ) );
+    }
+
+    for( int scale = 0; scale < m_nofScales; ++scale )
+    {
+        if( !m_references[ scale ]->isValid() )
+        {
+#ifdef USE_LOG4CXX
+            LOG4CXX_ERROR( loggerTransformation, "pyramid of the original could not be created" );
+#endif //USE_LOG4CXX
+            m_references.clear();
+            return;
+        }
+    }
+}
+
+bool MultiScaleSSIM::compare( const ImageInterface & candidate,
+                              double dssimAvgMax,
+                              double dssimPeakMax,
+                              double & dssim,
+                              double & dssimPeak ) const
+{
+    if(    ( !isValid() )
+        || ( m_references[0]->getWidth() != candidate.getWidth() )
+        || ( m_references[0]->getHeight() != candidate.getHeight() )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "MS-SSIM is not applicable (" << __FILE__ << ", " << __LINE__ << ")" );
+#endif //USE_LOG4CXX
+        return false;
+    }
+
+    // constants for SSIM
+    const double ssimL  = 255;   // 2**(#bits per pixel) - 1
+    const double ssimC1 = ( 0.01 * ssimL ) * ( 0.01 * ssimL );
+    const double ssimC2 = ( 0.03 * ssimL ) * ( 0.03 * ssimL );
+
+    const double nofPixels = static_cast<double>( windowSize * windowSize );
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate MS-SSIM ..." );
+#endif //USE_LOG4CXX
+
+    // the pyramid is built from fine to coarse, but evaluated the other way round
+    std::vector<ImageAverage> levels( m_nofScales - 1 );
+
+    for( int scale = 1; scale < m_nofScales; ++scale )
+    {
+        levels[ scale - 1 ] = ( scale == 1 ) ? ImageAverage( candidate, 2 ) : ImageAverage( levels[ scale - 2 ], 2 );
+    }
+
+    const int nofChunks = m_widthInChunks * m_heightInChunks;
+
+    double product = 1.0;
+    std::vector<double> chunkProducts( nofChunks, 1.0 );
+    std::vector<double> chunkSums( nofChunks );
+    std::vector<int>    chunkCounts( nofChunks );
+
+    for( int scale = m_nofScales - 1; scale >= 0; --scale )
+    {
+        const ImageInterface & image = ( scale == 0 ) ? candidate : levels[ scale - 1 ];
+        const ImageStatistics statistics( *m_references[ scale ], image );
+
+        if( !statistics.isValid() )
+        {
+            return false;
+        }
+
+        const bool coarsest = ( scale == m_nofScales - 1 );
+
+        chunkSums.assign( nofChunks, 0.0 );
+        chunkCounts.assign( nofChunks, 0 );
+        double sum = 0.0;
+
+        for( int yWindow = 0; yWindow < statistics.getHeight(); ++yWindow )
+        {
+            // each window belongs to the chunk of its center
+            const int yChunk = ( ( ( yWindow * windowSize ) << scale ) + ( ( windowSize / 2 ) << scale ) ) / m_averaging;
+
+            for( int xWindow = 0; xWindow < statistics.getWidth(); ++xWindow )
+            {
+                const ChunkStatistics & window = statistics.getChunk( xWindow, yWindow );
+
+                const double mean1      = window.sum1 / nofPixels;
+                const double mean2      = window.sum2 / nofPixels;
+                const double variance1  = window.sumOfSquares1 / nofPixels - mean1 * mean1;
+                const double variance2  = window.sumOfSquares2 / nofPixels - mean2 * mean2;
+                const double covariance = window.sumOfProducts / nofPixels - mean1 * mean2;
+
+                double term = ( 2.0 * covariance + ssimC2 ) / ( variance1 + variance2 + ssimC2 );
+
+                if( coarsest )
+                {
+                    term *= ( 2.0 * mean1 * mean2 + ssimC1 ) / ( mean1 * mean1 + mean2 * mean2 + ssimC1 );
+                }
+
+                sum += term;
+
+                const int xChunk = ( ( ( xWindow * windowSize ) << scale ) + ( ( windowSize / 2 ) << scale ) ) / m_averaging;
+
+                if(    ( xChunk < m_widthInChunks )
+                    && ( yChunk < m_heightInChunks )
+                  )
+                {
+                    chunkSums[ yChunk * m_widthInChunks + xChunk ] += term;
+                    chunkCounts[ yChunk * m_widthInChunks + xChunk ]++;
+                }
+            }
+        }
+
+        // a negative mean would not have a real power; it is as bad as 0 anyway
+        const double mean = sum / ( static_cast<double>( statistics.getWidth() ) * statistics.getHeight() );
+        product *= std::pow( std::max( mean, 0.0 ), m_weights[ scale ] );
+
+        double productMin = product;
+
+        for( int i = 0; i < nofChunks; ++i )
+        {
+            // windows of the coarse scales may be bigger than the chunks
+            const double chunkMean = ( chunkCounts[i] > 0 ) ? chunkSums[i] / chunkCounts[i] : mean;
+            chunkProducts[i] *= std::pow( std::max( chunkMean, 0.0 ), m_weights[ scale ] );
+            productMin = std::min( productMin, chunkProducts[i] );
+        }
+
+        dssim     = ( 1.0 - product ) / 2.0;
+        dssimPeak = ( 1.0 - productMin ) / 2.0;
+
+        if(    ( scale > 0 )
+            && (    ( dssim >= dssimAvgMax )
+                 || ( dssimPeak >= dssimPeakMax )
+               )
+          )
+        {
+#ifdef USE_LOG4CXX
+            LOG4CXX_INFO( loggerTransformation, "calculate MS-SSIM ... rejected at scale " << scale );
+#endif //USE_LOG4CXX
+            return true;
+        }
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate MS-SSIM ... done" );
+#endif //USE_LOG4CXX
+
+    return true;
+}
+
+} //namespace imageshrink
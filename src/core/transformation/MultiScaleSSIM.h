@@ -0,0 +1,81 @@
+
+#ifndef MULTISCALESSIM_H_
+#define MULTISCALESSIM_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+
+// include application headers
+#include "ImageInterface.h"
+#include "ImageReferenceContext.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class MultiScaleSSIM;
+typedef std::shared_ptr<MultiScaleSSIM> MultiScaleSSIMShrdPtr;
+typedef std::weak_ptr<MultiScaleSSIM>   MultiScaleSSIMWkPtr;
+
+// declaration
+// MS-SSIM of Wang et al. on the first plane: the images are halved with
+// ImageAverage up to four times; the contrast/structure term is taken at
+// every scale, the luminance term only at the coarsest one. The windows
+// are 8x8 boxes at every scale.
+// The scales are evaluated from coarse to fine. All terms are <= 1, so
+// the product of the coarse scales bounds the MS-SSIM from above; a
+// candidate exceeding the limits is rejected before the fine scales.
+class MultiScaleSSIM
+: public std::enable_shared_from_this<MultiScaleSSIM>
+{
+    //********** PRELIMINARY **********
+    public:
+        static const int maxNofScales = 5;
+        static const int windowSize   = 8;    // in pixels of each scale
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        MultiScaleSSIM( const ImageInterface & original, int averaging );
+        virtual ~MultiScaleSSIM() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        int                                       m_averaging;        // chunk size of the peak DSSIM
+        int                                       m_widthInChunks;
+        int                                       m_heightInChunks;
+        int                                       m_nofScales;
+        double                                    m_weights[ maxNofScales ];
+        std::vector<ImageReferenceContextShrdPtr> m_references;       // finest scale first
+
+    //********** METHODS **********
+    public:
+        bool isValid() const { return !m_references.empty(); }
+        int getNofScales() const { return m_nofScales; }
+
+        // thread safe; returns false if the candidate does not match the original;
+        // if a limit is exceeded before the finest scale, dssim and dssimPeak
+        // are lower bounds only
+        bool compare( const ImageInterface & candidate,
+                      double dssimAvgMax,
+                      double dssimPeakMax,
+                      double & dssim,
+                      double & dssimPeak ) const;
+
+    protected:
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //MULTISCALESSIM_H_
@@ -0,0 +1,129 @@
+
+// include system headers
+#include <algorithm>    // std::min, std::max
+#include <vector>
+
+// include own headers
+#include "SlidingWindowDSSIM.h"
+
+// include application headers
+#include "ImageDSSIM.h"
+#include "SummedAreaTable.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+#endif //USE_LOG4CXX
+
+SlidingWindowDSSIM::SlidingWindowDSSIM( ImageReferenceContextShrdPtr reference, int stride )
+: m_reference( reference )
+, m_stride( stride )
+{
+    // nothing
+}
+
+bool SlidingWindowDSSIM::isValid() const
+{
+    return    ( m_reference )
+           && ( m_reference->isValid() )
+           && ( m_stride > 0 )
+           && ( m_reference->getAveraging() * m_reference->getAveraging() <= SummedAreaTable::maxWindowPixels );
+}
+
+bool SlidingWindowDSSIM::calcPeak( const ImageInterface & candidate, double & dssimPeak, StatisticsPrecision::VALUE precision ) const
+{
+    ImageBufferShrdPtr imageBuffer = candidate.getImageBuffer();
+    int bytesPerPixel = 0;
+    int bytesPerLine  = 0;
+
+    if(    ( !isValid() )
+        || ( !imageBuffer )
+        || ( m_reference->getPixelFormat() != candidate.getPixelFormat() )
+        || ( m_reference->getWidth() != candidate.getWidth() )
+        || ( m_reference->getHeight() != candidate.getHeight() )
+        || ( !ImageReferenceContext::getFirstPlaneLayout( candidate, bytesPerPixel, bytesPerLine ) )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "sliding window DSSIM is not applicable (" << __FILE__ << ", " << __LINE__ << ")" );
+#endif //USE_LOG4CXX
+        return false;
+    }
+
+    const ImageReferenceContext & reference = *m_reference;
+    const unsigned char * const plane = imageBuffer->image;
+
+    const int width     = reference.getWidth();
+    const int height    = reference.getHeight();
+    const int window    = reference.getAveraging();
+    const int64_t nofPixels = static_cast<int64_t>( window ) * window;
+
+    const int nofWindowsX = ( width - window ) / m_stride + 1;
+    const int nofWindowsY = ( height - window ) / m_stride + 1;
+
+    // a band holds the lines of several window rows; its lines overlap
+    // with the next band by less than one window
+    const int windowRowsPerBand = std::max( 1, window / m_stride ) + 1;
+    const int nofBands = ( nofWindowsY + windowRowsPerBand - 1 ) / windowRowsPerBand;
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate sliding window DSSIM ..." );
+#endif //USE_LOG4CXX
+
+    double peak = -1.0;
+
+    #pragma omp parallel reduction(max:peak)
+    {
+        SummedAreaTable table;
+        std::vector<const unsigned char *> lines1;
+        std::vector<const unsigned char *> lines2;
+
+        #pragma omp for schedule(dynamic, 1)
+        for( int band = 0; band < nofBands; ++band )
+        {
+            const int firstWindowRow = band * windowRowsPerBand;
+            const int lastWindowRow  = std::min( firstWindowRow + windowRowsPerBand, nofWindowsY ) - 1;
+            const int firstLine      = firstWindowRow * m_stride;
+            const int nofLines       = lastWindowRow * m_stride + window - firstLine;
+
+            lines1.resize( nofLines );
+            lines2.resize( nofLines );
+
+            for( int i = 0; i < nofLines; ++i )
+            {
+                lines1[i] = reference.getPlaneLine( firstLine + i );
+                lines2[i] = &plane[ ( firstLine + i ) * bytesPerLine ];
+            }
+
+            table.calcTable( lines1.data(), lines2.data(), bytesPerPixel, width, firstLine, nofLines );
+
+            for( int yWindow = firstWindowRow; yWindow <= lastWindowRow; ++yWindow )
+            {
+                for( int xWindow = 0; xWindow < nofWindowsX; ++xWindow )
+                {
+                    const ChunkStatistics sums = table.getWindow( xWindow * m_stride, yWindow * m_stride, window, window );
+                    const double dssim = ImageDSSIM::calcChunkDSSIM( sums, nofPixels, precision );
+
+                    if( dssim > peak )
+                        peak = dssim;
+                }
+            }
+        }
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate sliding window DSSIM ... done (" << nofWindowsX * nofWindowsY << " windows)" );
+#endif //USE_LOG4CXX
+
+    dssimPeak = peak;
+    return true;
+}
+
+} //namespace imageshrink
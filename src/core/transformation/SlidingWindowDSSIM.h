@@ -0,0 +1,66 @@
+
+#ifndef SLIDINGWINDOWDSSIM_H_
+#define SLIDINGWINDOWDSSIM_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "ImageInterface.h"
+#include "ImageReferenceContext.h"
+#include "enumStatisticsPrecision.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class SlidingWindowDSSIM;
+typedef std::shared_ptr<SlidingWindowDSSIM> SlidingWindowDSSIMShrdPtr;
+typedef std::weak_ptr<SlidingWindowDSSIM>   SlidingWindowDSSIMWkPtr;
+
+// declaration
+// peak DSSIM over overlapping windows of the chunk size, placed every
+// `stride` pixels in both directions; the window sums come from summed
+// area tables, so the cost per window does not depend on its size.
+// With stride == chunk size the windows are the chunks of ImageDSSIM.
+class SlidingWindowDSSIM
+: public std::enable_shared_from_this<SlidingWindowDSSIM>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        SlidingWindowDSSIM( ImageReferenceContextShrdPtr reference, int stride );
+        virtual ~SlidingWindowDSSIM() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        ImageReferenceContextShrdPtr m_reference;
+        int                          m_stride;
+
+    //********** METHODS **********
+    public:
+        bool isValid() const;
+
+        // thread safe; returns false if the candidate does not match the reference
+        bool calcPeak( const ImageInterface & candidate, double & dssimPeak,
+                       StatisticsPrecision::VALUE precision = StatisticsPrecision::BITS_8 ) const;
+
+    protected:
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //SLIDINGWINDOWDSSIM_H_
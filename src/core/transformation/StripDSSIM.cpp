@@ -0,0 +1,188 @@
+
+// include system headers
+#include <vector>
+
+// include own headers
+#include "StripDSSIM.h"
+
+// include application headers
+#include "ImageStatistics.h"
+#include "ImageDSSIM.h"
+
+// include 3rd party headers
+#ifdef USE_LOG4CXX
+#include <log4cxx/logger.h>
+#endif //USE_LOG4CXX
+
+namespace imageshrink
+{
+
+#ifdef USE_LOG4CXX
+static log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+#endif //USE_LOG4CXX
+
+StripDSSIM::StripDSSIM( const ImageJfif & original, ChrominanceSubsampling::VALUE cs, int averaging )
+: m_original( original )
+, m_chrominanceSubsampling( cs )
+, m_averaging( averaging )
+, m_widthInChunks( 0 )
+, m_heightInChunks( 0 )
+{
+    if(    ( !m_original.isHeaderValid() )
+        || ( m_averaging <= 0 )
+      )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "no compressed image available" );
+#endif //USE_LOG4CXX
+        return;
+    }
+
+    // like ImageAverage, incomplete chunks at the right and bottom border are ignored
+    m_widthInChunks  = m_original.getWidth() / m_averaging;
+    m_heightInChunks = m_original.getHeight() / m_averaging;
+}
+
+const unsigned char * StripDSSIM::getLumaLine( JpegStripDecoder & decoder, int y )
+{
+    const int linesPerRow = decoder.getLinesPerRow( 0 );
+    const int row         = y / linesPerRow;
+
+    while( decoder.getNofRowsRead() <= row )
+    {
+        if( !decoder.readRow() )
+        {
+            return nullptr;
+        }
+    }
+
+    return decoder.getLine( 0, y % linesPerRow );
+}
+
+bool StripDSSIM::compare( int quality, StatisticsPrecision::VALUE precision, double & dssim, double & dssimPeak ) const
+{
+    long long candidateSize = 0;
+
+    return compare( quality, precision, dssim, dssimPeak, candidateSize );
+}
+
+bool StripDSSIM::compare( int quality, StatisticsPrecision::VALUE precision, double & dssim, double & dssimPeak, long long & candidateSize ) const
+{
+    if( !isValid() )
+    {
+#ifdef USE_LOG4CXX
+        LOG4CXX_ERROR( loggerTransformation, "DSSIM in strips is not available" );
+#endif //USE_LOG4CXX
+        return false;
+    }
+
+    // the candidate is kept compressed only
+    ImageBufferShrdPtr candidate = m_original.compressInStrips( quality, m_chrominanceSubsampling, false );
+
+    if( !candidate )
+    {
+        return false;
+    }
+
+    candidateSize = candidate->size;
+
+    JpegStripDecoder decoder1( m_original.getCompressedImageBuffer() );
+    JpegStripDecoder decoder2( candidate );
+
+    if(    ( !decoder1.isValid() )
+        || ( !decoder2.isValid() )
+      )
+    {
+        return false;
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate SSIM in strips ..." );
+#endif //USE_LOG4CXX
+
+    const int64_t nofPixels = static_cast<int64_t>( m_averaging ) * m_averaging;
+    std::vector<ChunkStatistics> chunkLine( m_widthInChunks );
+
+    double dssimSum = 0.0;
+    double dssimMax = -1.0;
+
+    for( int yChunk = 0; yChunk < m_heightInChunks; ++yChunk )
+    {
+        chunkLine.assign( m_widthInChunks, ChunkStatistics() );
+
+        // each line segment of a chunk fits into 32 bit sums (256 * 255 * 255 < 2^31)
+        for( int yOffset = 0; yOffset < m_averaging; ++yOffset )
+        {
+            const int y = yChunk * m_averaging + yOffset;
+            const unsigned char * const line1 = getLumaLine( decoder1, y );
+            const unsigned char * const line2 = getLumaLine( decoder2, y );
+
+            if(    ( line1 == nullptr )
+                || ( line2 == nullptr )
+              )
+            {
+#ifdef USE_LOG4CXX
+                LOG4CXX_ERROR( loggerTransformation, "line " << y << " could not be decoded" );
+#endif //USE_LOG4CXX
+                return false;
+            }
+
+            for( int xChunk = 0; xChunk < m_widthInChunks; ++xChunk )
+            {
+                const unsigned char * const segment1 = &line1[ xChunk * m_averaging ];
+                const unsigned char * const segment2 = &line2[ xChunk * m_averaging ];
+
+                int sum1 = 0;
+                int sum2 = 0;
+                int sumOfSquares1 = 0;
+                int sumOfSquares2 = 0;
+                int sumOfProducts = 0;
+
+                for( int x = 0; x < m_averaging; ++x )
+                {
+                    const int value1 = segment1[x];
+                    const int value2 = segment2[x];
+
+                    sum1          += value1;
+                    sum2          += value2;
+                    sumOfSquares1 += value1 * value1;
+                    sumOfSquares2 += value2 * value2;
+                    sumOfProducts += value1 * value2;
+                }
+
+                ChunkStatistics & chunk = chunkLine[ xChunk ];
+                chunk.sum1          += sum1;
+                chunk.sum2          += sum2;
+                chunk.sumOfSquares1 += sumOfSquares1;
+                chunk.sumOfSquares2 += sumOfSquares2;
+                chunk.sumOfProducts += sumOfProducts;
+            }
+        }
+
+        // same reduction as ImageDSSIM
+        double dssimLineSum = 0.0;
+
+        for( int xChunk = 0; xChunk < m_widthInChunks; ++xChunk )
+        {
+            const double dssimChunk = ImageDSSIM::calcChunkDSSIM( chunkLine[ xChunk ], nofPixels, precision );
+
+            dssimLineSum += dssimChunk;
+
+            if( dssimChunk > dssimMax )
+                dssimMax = dssimChunk;
+        }
+
+        dssimSum += ( dssimLineSum / static_cast<double>( m_widthInChunks ) );
+    }
+
+#ifdef USE_LOG4CXX
+    LOG4CXX_INFO( loggerTransformation, "calculate SSIM in strips ... done" );
+#endif //USE_LOG4CXX
+
+    dssim     = dssimSum / static_cast<double>( m_heightInChunks );
+    dssimPeak = dssimMax;
+
+    return true;
+}
+
+} //namespace imageshrink
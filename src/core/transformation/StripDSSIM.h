@@ -0,0 +1,73 @@
+
+#ifndef STRIPDSSIM_H_
+#define STRIPDSSIM_H_
+
+// include system headers
+#include <memory> // for smart pointer
+
+// include application headers
+#include "ImageJfif.h"
+#include "JpegStripDecoder.h"
+#include "enumStatisticsPrecision.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class StripDSSIM;
+typedef std::shared_ptr<StripDSSIM> StripDSSIMShrdPtr;
+typedef std::weak_ptr<StripDSSIM>   StripDSSIMWkPtr;
+
+// declaration
+// DSSIM of the luminance between the source file and its recompression
+// with a given quality (block metric); the candidate is transcoded in
+// strips, then source and candidate are decoded side by side and the chunk
+// statistics are accumulated one chunk line at a time. So neither image is
+// decoded completely; the memory depends on the width only.
+class StripDSSIM
+: public std::enable_shared_from_this<StripDSSIM>
+{
+    //********** PRELIMINARY **********
+    public:
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        // the original has to keep its compressed image (it needs not be decompressed)
+        StripDSSIM( const ImageJfif & original, ChrominanceSubsampling::VALUE cs, int averaging );
+        virtual ~StripDSSIM() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        ImageJfif                     m_original;
+        ChrominanceSubsampling::VALUE m_chrominanceSubsampling;
+        int                           m_averaging;
+        int                           m_widthInChunks;
+        int                           m_heightInChunks;
+
+    //********** METHODS **********
+    public:
+        bool isValid() const { return ( m_widthInChunks > 0 ) && ( m_heightInChunks > 0 ); }
+
+        // thread safe; returns false if the engine is not valid or a strip could not be transcoded
+        bool compare( int quality, StatisticsPrecision::VALUE precision, double & dssim, double & dssimPeak ) const;
+        bool compare( int quality, StatisticsPrecision::VALUE precision, double & dssim, double & dssimPeak, long long & candidateSize ) const;
+
+    protected:
+
+    private:
+        // luminance lines have to be requested in ascending order
+        static const unsigned char * getLumaLine( JpegStripDecoder & decoder, int y );
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //STRIPDSSIM_H_
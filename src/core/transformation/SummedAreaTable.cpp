@@ -0,0 +1,80 @@
+
+// include system headers
+// ...
+
+// include own headers
+#include "SummedAreaTable.h"
+
+// include application headers
+// ...
+
+// include 3rd party headers
+// ...
+
+namespace imageshrink
+{
+
+SummedAreaTable::SummedAreaTable()
+: m_width( 0 )
+, m_firstLine( 0 )
+, m_nofLines( 0 )
+, m_table()
+{
+    // nothing
+}
+
+void SummedAreaTable::calcTable( const unsigned char * const * lines1,
+                                 const unsigned char * const * lines2,
+                                 int bytesPerPixel2,
+                                 int width,
+                                 int firstLine,
+                                 int nofLines )
+{
+    const int stride = width + 1;
+
+    m_width     = width;
+    m_firstLine = firstLine;
+    m_nofLines  = nofLines;
+
+    // first line and first column are zero
+    const Entry zero = { 0, 0, 0, 0, 0 };
+    m_table.resize( ( nofLines + 1 ) * stride );
+
+    for( int x = 0; x < stride; ++x )
+    {
+        m_table[x] = zero;
+    }
+
+    for( int y = 0; y < nofLines; ++y )
+    {
+        const unsigned char * const line1 = lines1[y];
+        const unsigned char * const line2 = lines2[y];
+
+        const Entry * const above = &m_table[ y * stride ];
+        Entry * const current     = &m_table[ ( y + 1 ) * stride ];
+
+        Entry lineSums = zero;
+        current[0] = zero;
+
+        for( int x = 0; x < width; ++x )
+        {
+            const uint32_t value1 = line1[x];
+            const uint32_t value2 = line2[ x * bytesPerPixel2 ];
+
+            lineSums.sum1          += value1;
+            lineSums.sum2          += value2;
+            lineSums.sumOfSquares1 += value1 * value1;
+            lineSums.sumOfSquares2 += value2 * value2;
+            lineSums.sumOfProducts += value1 * value2;
+
+            Entry & entry = current[ x + 1 ];
+            entry.sum1          = above[ x + 1 ].sum1          + lineSums.sum1;
+            entry.sum2          = above[ x + 1 ].sum2          + lineSums.sum2;
+            entry.sumOfSquares1 = above[ x + 1 ].sumOfSquares1 + lineSums.sumOfSquares1;
+            entry.sumOfSquares2 = above[ x + 1 ].sumOfSquares2 + lineSums.sumOfSquares2;
+            entry.sumOfProducts = above[ x + 1 ].sumOfProducts + lineSums.sumOfProducts;
+        }
+    }
+}
+
+} //namespace imageshrink
@@ -0,0 +1,104 @@
+
+#ifndef SUMMEDAREATABLE_H_
+#define SUMMEDAREATABLE_H_
+
+// include system headers
+#include <memory> // for smart pointer
+#include <vector>
+#include <cstdint>
+
+// include application headers
+#include "ImageStatistics.h"
+
+namespace imageshrink
+{
+
+// create convenient types
+class SummedAreaTable;
+typedef std::shared_ptr<SummedAreaTable> SummedAreaTableShrdPtr;
+typedef std::weak_ptr<SummedAreaTable>   SummedAreaTableWkPtr;
+
+// declaration
+// integral images of sum, sum of squares and sum of products of the first
+// plane of two images over a band of lines; the sums of any window inside
+// the band cost four lookups. The entries wrap around modulo 2^32, which
+// keeps the window sums exact as long as they fit into 32 bits
+// (windows of up to 66051 pixels)
+class SummedAreaTable
+: public std::enable_shared_from_this<SummedAreaTable>
+{
+    //********** PRELIMINARY **********
+    public:
+        static const int maxWindowPixels = 66051;   // 255 * 255 * 66051 < 2^32
+
+    private:
+        struct Entry
+        {
+            uint32_t sum1;
+            uint32_t sum2;
+            uint32_t sumOfSquares1;
+            uint32_t sumOfSquares2;
+            uint32_t sumOfProducts;
+        };
+
+    //********** (DE/CON)STRUCTORS **********
+    public:
+        SummedAreaTable();
+        virtual ~SummedAreaTable() {}
+
+    protected:
+
+    private:
+
+    //********** ATTRIBUTES **********
+    public:
+
+    protected:
+
+    private:
+        int                m_width;      // in pixels
+        int                m_firstLine;
+        int                m_nofLines;
+        std::vector<Entry> m_table;      // ( m_nofLines + 1 ) x ( m_width + 1 )
+
+    //********** METHODS **********
+    public:
+        // lines [firstLine, firstLine + nofLines) of both planes; the
+        // storage is kept for the next band
+        void calcTable( const unsigned char * const * lines1,
+                        const unsigned char * const * lines2,
+                        int bytesPerPixel2,
+                        int width,
+                        int firstLine,
+                        int nofLines );
+
+        // window with its top left pixel at (x, y) in image coordinates
+        ChunkStatistics getWindow( int x, int y, int width, int height ) const
+        {
+            const int row0 = ( y - m_firstLine ) * ( m_width + 1 );
+            const int row1 = row0 + height * ( m_width + 1 );
+
+            const Entry & a = m_table[ row0 + x ];
+            const Entry & b = m_table[ row0 + x + width ];
+            const Entry & c = m_table[ row1 + x ];
+            const Entry & d = m_table[ row1 + x + width ];
+
+            ChunkStatistics ret;
+            ret.sum1          = static_cast<uint32_t>( d.sum1 - b.sum1 - c.sum1 + a.sum1 );
+            ret.sum2          = static_cast<uint32_t>( d.sum2 - b.sum2 - c.sum2 + a.sum2 );
+            ret.sumOfSquares1 = static_cast<uint32_t>( d.sumOfSquares1 - b.sumOfSquares1 - c.sumOfSquares1 + a.sumOfSquares1 );
+            ret.sumOfSquares2 = static_cast<uint32_t>( d.sumOfSquares2 - b.sumOfSquares2 - c.sumOfSquares2 + a.sumOfSquares2 );
+            ret.sumOfProducts = static_cast<uint32_t>( d.sumOfProducts - b.sumOfProducts - c.sumOfProducts + a.sumOfProducts );
+
+            return ret;
+        }
+
+    protected:
+
+    private:
+
+}; //class
+
+} //namespace imageshrink
+
+#endif //SUMMEDAREATABLE_H_
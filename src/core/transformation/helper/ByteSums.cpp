@@ -0,0 +1,244 @@
+
+// include system headers
+#if defined(__x86_64__) || defined(__i386__)
+#define BYTESUMS_X86
+#include <immintrin.h>
+#endif
+
+// include own headers
+#include "ByteSums.h"
+
+namespace imageshrink
+{
+
+typedef int  (*SumOfBytesFunc)( const unsigned char * data, int count );
+typedef void (*SumOfBytes3Func)( const unsigned char * data, int nofPixels, int & sum1, int & sum2, int & sum3 );
+
+struct ByteSumsImplementation
+{
+    const char *    name;
+    SumOfBytesFunc  sumOfBytes;
+    SumOfBytes3Func sumOfBytes3;
+};
+
+//********** scalar **********
+
+static int sumOfBytes_scalar( const unsigned char * data, int count )
+{
+    int sum = 0;
+
+    for( int i = 0; i < count; ++i )
+    {
+        sum += data[i];
+    }
+
+    return sum;
+}
+
+static void sumOfBytes3_scalar( const unsigned char * data, int nofPixels, int & sum1, int & sum2, int & sum3 )
+{
+    int s1 = 0;
+    int s2 = 0;
+    int s3 = 0;
+
+    for( int i = 0; i < nofPixels; ++i )
+    {
+        s1 += data[ 3 * i + 0 ];
+        s2 += data[ 3 * i + 1 ];
+        s3 += data[ 3 * i + 2 ];
+    }
+
+    sum1 = s1;
+    sum2 = s2;
+    sum3 = s3;
+}
+
+#ifdef BYTESUMS_X86
+
+// byte masks selecting one channel of interleaved 3 channel pixels; the
+// pattern repeats every 3 bytes, so a mask for a vector at byte offset k
+// starts at masks[channel][k % 96]
+alignas(32) static const unsigned char channelMasks[3][96] =
+{
+#define M0 0xFF, 0x00, 0x00
+#define M1 0x00, 0xFF, 0x00
+#define M2 0x00, 0x00, 0xFF
+    { M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0, M0 },
+    { M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1, M1 },
+    { M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2, M2 }
+#undef M0
+#undef M1
+#undef M2
+};
+
+//********** SSE2 **********
+
+// psadbw against zero delivers the byte sums of both 64 bit halves
+__attribute__((target("sse2")))
+static inline int horizontalSum_sse2( __m128i acc )
+{
+    return _mm_cvtsi128_si32( acc ) + _mm_cvtsi128_si32( _mm_srli_si128( acc, 8 ) );
+}
+
+__attribute__((target("sse2")))
+static int sumOfBytes_sse2( const unsigned char * data, int count )
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    int i = 0;
+
+    for( ; i + 16 <= count; i += 16 )
+    {
+        const __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i *>( &data[i] ) );
+        acc = _mm_add_epi64( acc, _mm_sad_epu8( v, zero ) );
+    }
+
+    return horizontalSum_sse2( acc ) + sumOfBytes_scalar( &data[i], count - i );
+}
+
+__attribute__((target("sse2")))
+static void sumOfBytes3_sse2( const unsigned char * data, int nofPixels, int & sum1, int & sum2, int & sum3 )
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc1 = zero;
+    __m128i acc2 = zero;
+    __m128i acc3 = zero;
+    int i = 0;
+
+    // 16 pixels (three vectors) per iteration
+    for( ; i + 16 <= nofPixels; i += 16 )
+    {
+        for( int k = 0; k < 48; k += 16 )
+        {
+            const __m128i v  = _mm_loadu_si128( reinterpret_cast<const __m128i *>( &data[ 3 * i + k ] ) );
+            const __m128i m1 = _mm_load_si128( reinterpret_cast<const __m128i *>( &channelMasks[0][k] ) );
+            const __m128i m2 = _mm_load_si128( reinterpret_cast<const __m128i *>( &channelMasks[1][k] ) );
+            const __m128i m3 = _mm_load_si128( reinterpret_cast<const __m128i *>( &channelMasks[2][k] ) );
+
+            acc1 = _mm_add_epi64( acc1, _mm_sad_epu8( _mm_and_si128( v, m1 ), zero ) );
+            acc2 = _mm_add_epi64( acc2, _mm_sad_epu8( _mm_and_si128( v, m2 ), zero ) );
+            acc3 = _mm_add_epi64( acc3, _mm_sad_epu8( _mm_and_si128( v, m3 ), zero ) );
+        }
+    }
+
+    int tail1 = 0;
+    int tail2 = 0;
+    int tail3 = 0;
+    sumOfBytes3_scalar( &data[ 3 * i ], nofPixels - i, tail1, tail2, tail3 );
+
+    sum1 = horizontalSum_sse2( acc1 ) + tail1;
+    sum2 = horizontalSum_sse2( acc2 ) + tail2;
+    sum3 = horizontalSum_sse2( acc3 ) + tail3;
+}
+
+//********** AVX2 **********
+
+__attribute__((target("avx2")))
+static inline int horizontalSum_avx2( __m256i acc )
+{
+    const __m128i acc128 = _mm_add_epi64( _mm256_castsi256_si128( acc ), _mm256_extracti128_si256( acc, 1 ) );
+    return _mm_cvtsi128_si32( acc128 ) + _mm_cvtsi128_si32( _mm_srli_si128( acc128, 8 ) );
+}
+
+__attribute__((target("avx2")))
+static int sumOfBytes_avx2( const unsigned char * data, int count )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    int i = 0;
+
+    for( ; i + 32 <= count; i += 32 )
+    {
+        const __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( &data[i] ) );
+        acc = _mm256_add_epi64( acc, _mm256_sad_epu8( v, zero ) );
+    }
+
+    return horizontalSum_avx2( acc ) + sumOfBytes_sse2( &data[i], count - i );
+}
+
+__attribute__((target("avx2")))
+static void sumOfBytes3_avx2( const unsigned char * data, int nofPixels, int & sum1, int & sum2, int & sum3 )
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc1 = zero;
+    __m256i acc2 = zero;
+    __m256i acc3 = zero;
+    int i = 0;
+
+    // 32 pixels (three vectors) per iteration
+    for( ; i + 32 <= nofPixels; i += 32 )
+    {
+        for( int k = 0; k < 96; k += 32 )
+        {
+            const __m256i v  = _mm256_loadu_si256( reinterpret_cast<const __m256i *>( &data[ 3 * i + k ] ) );
+            const __m256i m1 = _mm256_load_si256( reinterpret_cast<const __m256i *>( &channelMasks[0][k] ) );
+            const __m256i m2 = _mm256_load_si256( reinterpret_cast<const __m256i *>( &channelMasks[1][k] ) );
+            const __m256i m3 = _mm256_load_si256( reinterpret_cast<const __m256i *>( &channelMasks[2][k] ) );
+
+            acc1 = _mm256_add_epi64( acc1, _mm256_sad_epu8( _mm256_and_si256( v, m1 ), zero ) );
+            acc2 = _mm256_add_epi64( acc2, _mm256_sad_epu8( _mm256_and_si256( v, m2 ), zero ) );
+            acc3 = _mm256_add_epi64( acc3, _mm256_sad_epu8( _mm256_and_si256( v, m3 ), zero ) );
+        }
+    }
+
+    int tail1 = 0;
+    int tail2 = 0;
+    int tail3 = 0;
+    sumOfBytes3_sse2( &data[ 3 * i ], nofPixels - i, tail1, tail2, tail3 );
+
+    sum1 = horizontalSum_avx2( acc1 ) + tail1;
+    sum2 = horizontalSum_avx2( acc2 ) + tail2;
+    sum3 = horizontalSum_avx2( acc3 ) + tail3;
+}
+
+#endif //BYTESUMS_X86
+
+//********** dispatching **********
+
+static ByteSumsImplementation selectImplementation()
+{
+    ByteSumsImplementation ret = { "scalar", sumOfBytes_scalar, sumOfBytes3_scalar };
+
+#ifdef BYTESUMS_X86
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "avx2" ) )
+    {
+        ret.name        = "avx2";
+        ret.sumOfBytes  = sumOfBytes_avx2;
+        ret.sumOfBytes3 = sumOfBytes3_avx2;
+    }
+    else if( __builtin_cpu_supports( "sse2" ) )
+    {
+        ret.name        = "sse2";
+        ret.sumOfBytes  = sumOfBytes_sse2;
+        ret.sumOfBytes3 = sumOfBytes3_sse2;
+    }
+#endif //BYTESUMS_X86
+
+    return ret;
+}
+
+// determined once (thread safe initialization of local statics)
+static const ByteSumsImplementation & getImplementation()
+{
+    static const ByteSumsImplementation implementation = selectImplementation();
+    return implementation;
+}
+
+int sumOfBytes( const unsigned char * data, int count )
+{
+    return getImplementation().sumOfBytes( data, count );
+}
+
+void sumOfBytes3( const unsigned char * data, int nofPixels, int & sum1, int & sum2, int & sum3 )
+{
+    getImplementation().sumOfBytes3( data, nofPixels, sum1, sum2, sum3 );
+}
+
+const char * byteSumsImplementation()
+{
+    return getImplementation().name;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,19 @@
+
+#ifndef BYTESUMS_H_
+#define BYTESUMS_H_
+
+namespace imageshrink
+{
+
+// sum of count consecutive bytes
+int sumOfBytes( const unsigned char * data, int count );
+
+// sums of the three channels of nofPixels interleaved pixels (e.g. RGB)
+void sumOfBytes3( const unsigned char * data, int nofPixels, int & sum1, int & sum2, int & sum3 );
+
+// name of the implementation chosen for this cpu (avx2, sse2 or scalar)
+const char * byteSumsImplementation();
+
+} //namespace imageshrink
+
+#endif //BYTESUMS_H_
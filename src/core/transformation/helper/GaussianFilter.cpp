@@ -0,0 +1,175 @@
+
+// include system headers
+#include <cmath>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GAUSSIANFILTER_X86
+#endif
+
+// include own headers
+#include "GaussianFilter.h"
+
+namespace imageshrink
+{
+
+// the loops run over the pixels in the inner loop, so the compiler
+// vectorizes them with the instruction set of the calling function
+
+__attribute__((always_inline))
+static inline void filterLine_body( const float * __restrict in, const float * __restrict weights, int nofTaps, float * __restrict out, int nofOut )
+{
+    for( int i = 0; i < nofOut; ++i )
+    {
+        out[i] = weights[0] * in[i];
+    }
+
+    for( int k = 1; k < nofTaps; ++k )
+    {
+        const float weight = weights[k];
+        const float * __restrict shifted = in + k;
+
+        for( int i = 0; i < nofOut; ++i )
+        {
+            out[i] += weight * shifted[i];
+        }
+    }
+}
+
+__attribute__((always_inline))
+static inline void filterColumns_body( const float * const * lines, const float * __restrict weights, int nofTaps, float * __restrict out, int nofOut )
+{
+    {
+        const float weight = weights[0];
+        const float * __restrict line = lines[0];
+
+        for( int i = 0; i < nofOut; ++i )
+        {
+            out[i] = weight * line[i];
+        }
+    }
+
+    for( int k = 1; k < nofTaps; ++k )
+    {
+        const float weight = weights[k];
+        const float * __restrict line = lines[k];
+
+        for( int i = 0; i < nofOut; ++i )
+        {
+            out[i] += weight * line[i];
+        }
+    }
+}
+
+//********** generic (baseline instruction set of the build) **********
+
+static void filterLine_generic( const float * in, const float * weights, int nofTaps, float * out, int nofOut )
+{
+    filterLine_body( in, weights, nofTaps, out, nofOut );
+}
+
+static void filterColumns_generic( const float * const * lines, const float * weights, int nofTaps, float * out, int nofOut )
+{
+    filterColumns_body( lines, weights, nofTaps, out, nofOut );
+}
+
+#ifdef GAUSSIANFILTER_X86
+
+//********** SSE2 **********
+
+__attribute__((target("sse2")))
+static void filterLine_sse2( const float * in, const float * weights, int nofTaps, float * out, int nofOut )
+{
+    filterLine_body( in, weights, nofTaps, out, nofOut );
+}
+
+__attribute__((target("sse2")))
+static void filterColumns_sse2( const float * const * lines, const float * weights, int nofTaps, float * out, int nofOut )
+{
+    filterColumns_body( lines, weights, nofTaps, out, nofOut );
+}
+
+//********** AVX2 **********
+
+__attribute__((target("avx2,fma")))
+static void filterLine_avx2( const float * in, const float * weights, int nofTaps, float * out, int nofOut )
+{
+    filterLine_body( in, weights, nofTaps, out, nofOut );
+}
+
+__attribute__((target("avx2,fma")))
+static void filterColumns_avx2( const float * const * lines, const float * weights, int nofTaps, float * out, int nofOut )
+{
+    filterColumns_body( lines, weights, nofTaps, out, nofOut );
+}
+
+#endif //GAUSSIANFILTER_X86
+
+//********** dispatching **********
+
+static std::vector<GaussianFilterImplementation> listImplementations()
+{
+    std::vector<GaussianFilterImplementation> ret;
+
+#ifdef GAUSSIANFILTER_X86
+    __builtin_cpu_init();
+
+    if( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) )
+    {
+        const GaussianFilterImplementation avx2 = { "avx2", filterLine_avx2, filterColumns_avx2 };
+        ret.push_back( avx2 );
+    }
+
+    if( __builtin_cpu_supports( "sse2" ) )
+    {
+        const GaussianFilterImplementation sse2 = { "sse2", filterLine_sse2, filterColumns_sse2 };
+        ret.push_back( sse2 );
+    }
+#endif //GAUSSIANFILTER_X86
+
+    const GaussianFilterImplementation generic = { "generic", filterLine_generic, filterColumns_generic };
+    ret.push_back( generic );
+
+    return ret;
+}
+
+// determined once (thread safe initialization of local statics); the
+// best implementation comes first
+static const std::vector<GaussianFilterImplementation> & getImplementations()
+{
+    static const std::vector<GaussianFilterImplementation> implementations = listImplementations();
+    return implementations;
+}
+
+const GaussianFilterImplementation & getGaussianFilter()
+{
+    return getImplementations().front();
+}
+
+int getNofGaussianFilterImplementations()
+{
+    return static_cast<int>( getImplementations().size() );
+}
+
+const GaussianFilterImplementation & getGaussianFilterImplementation( int index )
+{
+    return getImplementations().at( index );
+}
+
+void calcGaussianWeights( float * weights, int nofTaps, double sigma )
+{
+    const double center = ( nofTaps - 1 ) / 2.0;
+    double sum = 0.0;
+
+    for( int k = 0; k < nofTaps; ++k )
+    {
+        sum += std::exp( -( k - center ) * ( k - center ) / ( 2.0 * sigma * sigma ) );
+    }
+
+    for( int k = 0; k < nofTaps; ++k )
+    {
+        weights[k] = static_cast<float>( std::exp( -( k - center ) * ( k - center ) / ( 2.0 * sigma * sigma ) ) / sum );
+    }
+}
+
+} //namespace imageshrink
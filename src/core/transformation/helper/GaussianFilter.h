@@ -0,0 +1,32 @@
+
+#ifndef GAUSSIANFILTER_H_
+#define GAUSSIANFILTER_H_
+
+namespace imageshrink
+{
+
+// kernels of the separable window filter of SSIM on float lines
+struct GaussianFilterImplementation
+{
+    const char * name;
+
+    // out[i] = sum( weights[k] * in[i + k] ), 0 <= k < nofTaps
+    void (*filterLine)( const float * in, const float * weights, int nofTaps, float * out, int nofOut );
+
+    // out[i] = sum( weights[k] * lines[k][i] ), 0 <= k < nofTaps
+    void (*filterColumns)( const float * const * lines, const float * weights, int nofTaps, float * out, int nofOut );
+};
+
+// implementation chosen for this cpu (avx2, sse2 or generic)
+const GaussianFilterImplementation & getGaussianFilter();
+
+// all implementations the cpu supports (e.g. for benchmarks)
+int getNofGaussianFilterImplementations();
+const GaussianFilterImplementation & getGaussianFilterImplementation( int index );
+
+// normalized weights of a sampled Gaussian
+void calcGaussianWeights( float * weights, int nofTaps, double sigma );
+
+} //namespace imageshrink
+
+#endif //GAUSSIANFILTER_H_
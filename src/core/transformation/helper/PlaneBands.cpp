@@ -0,0 +1,48 @@
+
+// include system headers
+#include <algorithm>    // std::max, std::min
+#include <cstdint>
+#include <omp.h>
+
+// include own headers
+#include "PlaneBands.h"
+
+namespace imageshrink
+{
+
+// several bands per thread balance planes of different cost
+static const int bandsPerThread = 4;
+
+std::vector<PlaneBand> calcPlaneBands( const int * costPerLine, const int * nofLines, int nofPlanes )
+{
+    std::vector<PlaneBand> ret;
+
+    int64_t totalCost = 0;
+
+    for( int plane = 0; plane < nofPlanes; ++plane )
+    {
+        totalCost += static_cast<int64_t>( costPerLine[ plane ] ) * nofLines[ plane ];
+    }
+
+    const int64_t nofBands    = static_cast<int64_t>( omp_get_max_threads() ) * bandsPerThread;
+    const int64_t costPerBand = std::max<int64_t>( 1, totalCost / nofBands );
+
+    for( int plane = 0; plane < nofPlanes; ++plane )
+    {
+        const int linesPerBand = std::max<int64_t>( 1, costPerBand / std::max( 1, costPerLine[ plane ] ) );
+
+        for( int y = 0; y < nofLines[ plane ]; y += linesPerBand )
+        {
+            PlaneBand band;
+            band.plane  = plane;
+            band.yBegin = y;
+            band.yEnd   = std::min( y + linesPerBand, nofLines[ plane ] );
+
+            ret.push_back( band );
+        }
+    }
+
+    return ret;
+}
+
+} //namespace imageshrink
@@ -0,0 +1,50 @@
+
+#ifndef PLANEBANDS_H_
+#define PLANEBANDS_H_
+
+// include system headers
+#include <vector>
+
+namespace imageshrink
+{
+
+// lines [yBegin, yEnd) of one plane
+struct PlaneBand
+{
+    int plane;
+    int yBegin;
+    int yEnd;
+};
+
+// splits the lines of several planes into bands of about the same cost;
+// costPerLine and nofLines have nofPlanes entries, planes without lines
+// get no band
+std::vector<PlaneBand> calcPlaneBands( const int * costPerLine, const int * nofLines, int nofPlanes );
+
+// processes the bands of all planes as OpenMP tasks, so every thread
+// works on every plane (no nested parallel regions); inside a parallel
+// region the bands are processed by the current thread;
+// function( plane, yBegin, yEnd ) has to be thread safe
+template<typename Function>
+void runPlaneBands( const std::vector<PlaneBand> & bands, Function function )
+{
+    const int nofBands = bands.size();
+
+    #pragma omp parallel if( nofBands > 1 )
+    {
+        #pragma omp single
+        {
+            for( int i = 0; i < nofBands; ++i )
+            {
+                const PlaneBand band = bands[i];
+
+                #pragma omp task firstprivate( band )
+                function( band.plane, band.yBegin, band.yEnd );
+            }
+        }
+    }
+}
+
+} //namespace imageshrink
+
+#endif //PLANEBANDS_H_
@@ -1,12 +1,15 @@
 
 #include <stdlib.h>
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include <string>
-#include <unordered_map>
 
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <omp.h>
+
 #ifdef USE_LOG4CXX
 #include <log4cxx/logger.h>
 #include <log4cxx/xml/domconfigurator.h>
@@ -14,12 +17,9 @@
 #include <log4cxx/consoleappender.h>
 #endif //USE_LOG4CXX
 
-#include "ImageDummy.h"
-#include "ImageJfif.h"
-#include "ImageAverage.h"
-#include "ImageVariance.h"
-#include "ImageCollection.h"
-#include "ImageDSSIM.h"
+#include "BatchProcessor.h"
+#include "ImageShrinker.h"
+#include "ResultCache.h"
 #include "settings.h"
 #include "usage.h"
 
@@ -28,20 +28,9 @@
 log4cxx::LoggerPtr loggerMain           ( log4cxx::Logger::getLogger( "main" ) );
 log4cxx::LoggerPtr loggerImage          ( log4cxx::Logger::getLogger( "image" ) );
 log4cxx::LoggerPtr loggerTransformation ( log4cxx::Logger::getLogger( "transformation" ) );
+log4cxx::LoggerPtr loggerSearch         ( log4cxx::Logger::getLogger( "search" ) );
 #endif //USE_LOG4CXX
 
-struct ImageComparisonResult
-{
-    ImageComparisonResult()
-    : dssimAvg( 0.0 )
-    , dssimPeak( 0.0 )
-    {}
-
-    double dssimAvg;
-    double dssimPeak;
-};
-
-
 int main( int argc, const char* argv[] )
 {
     // Initialize variables
@@ -259,6 +248,275 @@ int main( int argc, const char* argv[] )
                     }
 
 
+                    somethingDone = true;
+                }
+                else if( arg == "--parallelQualities" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    try {
+                        settings.parallelQualities = std::stoi( value );
+                    } catch (...) {
+                        error = true;
+                    }
+
+                    if(    ( settings.parallelQualities < Settings::parallelQualities_min )
+                        || ( settings.parallelQualities > Settings::parallelQualities_max )
+                       )
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--threads" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    try {
+                        settings.threads = std::stoi( value );
+                    } catch (...) {
+                        error = true;
+                    }
+
+                    if(    ( settings.threads < Settings::threads_min )
+                        || ( settings.threads > Settings::threads_max )
+                       )
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--memoryLimit" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    try {
+                        settings.memoryLimit = std::stoi( value );
+                    } catch (...) {
+                        error = true;
+                    }
+
+                    if(    ( settings.memoryLimit < Settings::memoryLimit_min )
+                        || ( settings.memoryLimit > Settings::memoryLimit_max )
+                       )
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--search" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    if( value == "linear" )
+                    {
+                        settings.qualitySearch = QualitySearch::LINEAR;
+                    }
+                    else if( value == "bisection" )
+                    {
+                        settings.qualitySearch = QualitySearch::BISECTION;
+                    }
+                    else if( value == "secant" )
+                    {
+                        settings.qualitySearch = QualitySearch::SECANT;
+                    }
+                    else
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--engine" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    if( value == "pixel" )
+                    {
+                        settings.comparisonEngine = ComparisonEngine::PIXEL;
+                    }
+                    else if( value == "dct" )
+                    {
+                        settings.comparisonEngine = ComparisonEngine::DCT;
+                    }
+                    else if( value == "strips" )
+                    {
+                        settings.comparisonEngine = ComparisonEngine::STRIPS;
+                    }
+                    else
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--dssimPeakStride" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    try {
+                        settings.dssimPeakStride = std::stoi( value );
+                    } catch (...) {
+                        error = true;
+                    }
+
+                    if(    ( settings.dssimPeakStride < Settings::dssimPeakStride_min )
+                        || ( settings.dssimPeakStride > Settings::dssimPeakStride_max )
+                       )
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--metric" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    if( value == "block" )
+                    {
+                        settings.similarityMetric = SimilarityMetric::BLOCK;
+                    }
+                    else if( value == "gaussian" )
+                    {
+                        settings.similarityMetric = SimilarityMetric::GAUSSIAN;
+                    }
+                    else if( value == "msssim" )
+                    {
+                        settings.similarityMetric = SimilarityMetric::MSSSIM;
+                    }
+                    else
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--dssimWeights" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    int length = 0;
+
+                    if(    ( std::sscanf( value.c_str(), "%lf,%lf,%lf%n", &settings.dssimWeightY, &settings.dssimWeightCb, &settings.dssimWeightCr, &length ) != 3 )
+                        || ( length != static_cast<int>( value.size() ) )
+                      )
+                    {
+                        error = true;
+                    }
+
+                    if(    ( settings.dssimWeightY < Settings::dssimWeight_min )
+                        || ( settings.dssimWeightY > Settings::dssimWeight_max )
+                        || ( settings.dssimWeightCb < Settings::dssimWeight_min )
+                        || ( settings.dssimWeightCb > Settings::dssimWeight_max )
+                        || ( settings.dssimWeightCr < Settings::dssimWeight_min )
+                        || ( settings.dssimWeightCr > Settings::dssimWeight_max )
+                        || ( settings.dssimWeightY + settings.dssimWeightCb + settings.dssimWeightCr <= 0.0 )
+                      )
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--statistics" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    if( value == "8bit" )
+                    {
+                        settings.statisticsPrecision = StatisticsPrecision::BITS_8;
+                    }
+                    else if( value == "float" )
+                    {
+                        settings.statisticsPrecision = StatisticsPrecision::FLOAT;
+                    }
+                    else
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--stats" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    if( value == "none" )
+                    {
+                        settings.stats = StatsFormat::NONE;
+                    }
+                    else if( value == "json" )
+                    {
+                        settings.stats = StatsFormat::JSON;
+                    }
+                    else
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--batch" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    if( value == "true" )
+                    {
+                        settings.batch = true;
+                    }
+                    else if( value == "false" )
+                    {
+                        settings.batch = false;
+                    }
+                    else
+                    {
+                        error = true;
+                    }
+
+                    somethingDone = true;
+                }
+                else if( arg == "--cache" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    settings.cacheFile = value;
+
+                    somethingDone = true;
+                }
+                else if( arg == "--estimateQuality" )
+                {
+                    const std::string value( argv[ pos ] );
+                    pos = pos + 1;
+
+                    if( value == "true" )
+                    {
+                        settings.estimateQuality = true;
+                    }
+                    else if( value == "false" )
+                    {
+                        settings.estimateQuality = false;
+                    }
+                    else
+                    {
+                        error = true;
+                    }
+
                     somethingDone = true;
                 }
             }
@@ -301,6 +559,7 @@ int main( int argc, const char* argv[] )
         loggerMain->addAppender           ( defaultAppender );
         loggerImage->addAppender          ( defaultAppender );
         loggerTransformation->addAppender ( defaultAppender );
+        loggerSearch->addAppender         ( defaultAppender );
 
 //        auto logLevel = log4cxx::Level::getDebug();
 //        auto logLevel = log4cxx::Level::getInfo();
@@ -312,129 +571,84 @@ int main( int argc, const char* argv[] )
         loggerMain->setLevel           ( logLevel );  // Log level set to DEBUG
         loggerImage->setLevel          ( logLevel );   // Log level set to INFO
         loggerTransformation->setLevel ( logLevel );   // Log level set to INFO
+        loggerSearch->setLevel         ( logLevel );
 
 //        std::cout << "Could not open Log4cxx configuration XML file: " << log4cxxConfigFile << std::endl;
 //        perror("Problem opening log4cxx config file");
     }
 #endif //USE_LOG4CXX
 
-    // reduce image size
-    do
+    // all parallel regions (and the batch workers) use this number of threads
+    if( settings.threads > 0 )
     {
-        imageshrink::ImageJfif imagejfif1( settings.inputFile );
+        omp_set_num_threads( settings.threads );
+    }
 
-        if( !imagejfif1.isImageValid() )
-        {
-            error = true;
-            std::cerr << "image file count not be loaded" << std::endl;
-            break;
-        }
+    // reduce image size
+    imageshrink::ResultCacheShrdPtr cache;
 
-        imageshrink::ImageCollection collection1;
-        {
-            imageshrink::ImageAverage image1Average   = imageshrink::ImageAverage( imagejfif1, settings.imageCompChunkSize );
-            imageshrink::ImageVariance image1Variance = imageshrink::ImageVariance( imagejfif1, image1Average, settings.imageCompChunkSize );
+    if( !settings.cacheFile.empty() )
+    {
+        cache = std::make_shared<imageshrink::ResultCache>( settings.cacheFile );
 
-            collection1.addImage( "original", std::make_shared<imageshrink::ImageDummy>( imagejfif1 ) );
-            collection1.addImage( "average",  std::make_shared<imageshrink::ImageDummy>( image1Average ) );
-            collection1.addImage( "variance", std::make_shared<imageshrink::ImageDummy>( image1Variance ) );
+        if( !cache->isValid() )
+        {
+            std::cerr << "result cache could not be opened" << std::endl;
+            return EXIT_FAILURE;
         }
+    }
 
-        int quality = settings.qualityMax;
-        int qualityStep = settings.initQualityStep;
-        std::unordered_map<int /*quality*/, ImageComparisonResult> icrMap;
+    if( settings.batch )
+    {
+        imageshrink::BatchProcessor batchProcessor( settings, cache );
 
-        ChrominanceSubsampling::VALUE cs = imagejfif1.getChrominanceSubsampling();
-        if(    ( cs == ChrominanceSubsampling::CS_444 )
-            && ( settings.cs444to420 )
-           )
+        if( !batchProcessor.run( settings.inputFile, settings.outputFile ) )
         {
-            cs = ChrominanceSubsampling::CS_420;
+            error = true;
         }
+    }
+    else
+    {
+        imageshrink::ImageShrinker shrinker( settings, cache );
+        const imageshrink::ShrinkResult result = shrinker.shrink( settings.inputFile, settings.outputFile );
 
-        while( qualityStep != 0 )
+        if( !result.stats.empty() )
         {
-            ImageComparisonResult icr;
-
-            while(    ( icr.dssimAvg < settings.dssimAvgMax )
-                   && ( icr.dssimPeak < settings.dssimPeakMax )
-                   && ( quality > settings.qualityMin )
-                 )
-            {
-                const auto icrMapEntry = icrMap.find( quality );
-
-                if( icrMapEntry == icrMap.end() )
-                {
-                    imageshrink::ImageJfif imagejfif2         = imagejfif1.getCompressedDecompressedImage( /*quality*/ quality, cs );
-                    imagejfif2                                = imagejfif2.getImageWithChrominanceSubsampling( imagejfif1.getChrominanceSubsampling() );
-                    imageshrink::ImageAverage image2Average   = imageshrink::ImageAverage( imagejfif2, settings.imageCompChunkSize );
-                    imageshrink::ImageVariance image2Variance = imageshrink::ImageVariance( imagejfif2, image2Average, settings.imageCompChunkSize );
-
-                    imageshrink::ImageCollection collection2;
-                    collection2.addImage( "original", std::make_shared<imageshrink::ImageDummy>( imagejfif2 ) );
-                    collection2.addImage( "average",  std::make_shared<imageshrink::ImageDummy>( image2Average ) );
-                    collection2.addImage( "variance", std::make_shared<imageshrink::ImageDummy>( image2Variance ) );
-
-                    imageshrink::ImageDSSIM imageDSSIM( collection1, collection2, settings.imageCompChunkSize );
-
-                    icr.dssimAvg  = imageDSSIM.getDssim();
-                    icr.dssimPeak = imageDSSIM.getDssimPeak();
-
-#ifdef USE_LOG4CXX
-                    LOG4CXX_WARN( loggerMain,
-                                 "DSSIM = "
-                                 << icr.dssimAvg
-                                 << "; DSSIM Peak = "
-                                 << icr.dssimPeak
-                                 << "; quality = " << quality
-                    );
-#endif //USE_LOG4CXX
-
-                    icrMap[ quality ] = icr;
-                }
-                else
-                {
-                    icr = icrMapEntry->second;
-
-#ifdef USE_LOG4CXX
-                    LOG4CXX_WARN( loggerMain,
-                                 "DSSIM = "
-                                 << icr.dssimAvg
-                                 << "; DSSIM Peak = "
-                                 << icr.dssimPeak
-                                 << "; quality = " << quality
-                                 << " (restored result)"
-                    );
-#endif //USE_LOG4CXX
-                }
-
-                quality -= qualityStep;
-            }
-
-            quality     += ( 2 * qualityStep );
-            qualityStep /= 2;   // qualityStep == 0: end of loop
-
-#ifdef USE_LOG4CXX
-            LOG4CXX_INFO( loggerMain, "qualityStep = " << qualityStep );
-#endif //USE_LOG4CXX
+            std::cout << result.stats << std::endl;
         }
 
-#ifdef USE_LOG4CXX
-        LOG4CXX_INFO( loggerMain, "final quality setting = " << quality );
-#else
-        std::cout << "final quality setting = " << quality << std::endl;
-#endif //USE_LOG4CXX
-
-        if( settings.copyMarkers )
+        if( !result.success )
         {
-            imageshrink::ImageJfif::ListOfMarkerShrdPtr markers = imagejfif1.getMarkers();
-            imagejfif1.storeInFile( settings.outputFile, markers, quality, cs );
+            error = true;
+            std::cerr << result.errorMessage << std::endl;
         }
         else
         {
-            imagejfif1.storeInFile( settings.outputFile, quality, cs );
+#ifdef USE_LOG4CXX
+            LOG4CXX_INFO( loggerMain, "final quality setting = " << result.quality );
+            LOG4CXX_INFO( loggerMain, "number of encodes (" << settings.qualitySearchAsString() << " search) = " << result.nofEvaluations );
+#else
+            std::cout << "final quality setting = " << result.quality << std::endl;
+            std::cout << "number of encodes (" << settings.qualitySearchAsString() << " search) = " << result.nofEvaluations << std::endl;
+
+            if(    ( result.compared )
+                && (    ( settings.dssimWeightCb > 0.0 )
+                     || ( settings.dssimWeightCr > 0.0 )
+                   )
+              )
+            {
+                std::cout << "DSSIM per plane (Y/Cb/Cr) = "
+                          << result.comparison.dssimAvgPlanes[0] << " / "
+                          << result.comparison.dssimAvgPlanes[1] << " / "
+                          << result.comparison.dssimAvgPlanes[2] << std::endl;
+                std::cout << "DSSIM peak per plane (Y/Cb/Cr) = "
+                          << result.comparison.dssimPeakPlanes[0] << " / "
+                          << result.comparison.dssimPeakPlanes[1] << " / "
+                          << result.comparison.dssimPeakPlanes[2] << std::endl;
+            }
+#endif //USE_LOG4CXX
         }
-    } while(0);
+    }
 
 
     // cleanup when application closes --> does not work for any reason
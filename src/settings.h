@@ -2,6 +2,14 @@
 #ifndef ENUM_SETTINGS_H_
 #define ENUM_SETTINGS_H_
 
+#include <string>
+
+#include "enumQualitySearch.h"
+#include "enumComparisonEngine.h"
+#include "enumSimilarityMetric.h"
+#include "enumStatisticsPrecision.h"
+#include "enumStatsFormat.h"
+
 struct Settings
 {
     Settings()
@@ -13,6 +21,21 @@ struct Settings
     , initQualityStep( initQualityStep_default )
     , cs444to420( cs444to420_default )
     , imageCompChunkSize( imageCompChunkSize_default )
+    , parallelQualities( parallelQualities_default )
+    , threads( threads_default )
+    , memoryLimit( memoryLimit_default )
+    , qualitySearch( qualitySearch_default )
+    , estimateQuality( estimateQuality_default )
+    , comparisonEngine( comparisonEngine_default )
+    , dssimPeakStride( dssimPeakStride_default )
+    , similarityMetric( similarityMetric_default )
+    , dssimWeightY( dssimWeightY_default )
+    , dssimWeightCb( dssimWeightCb_default )
+    , dssimWeightCr( dssimWeightCr_default )
+    , statisticsPrecision( statisticsPrecision_default )
+    , stats( stats_default )
+    , batch( batch_default )
+    , cacheFile()
     , inputFile()
     , outputFile()
     {}
@@ -54,6 +77,59 @@ struct Settings
     const static int imageCompChunkSize_max = 256;
     const static int imageCompChunkSize_default = 20 * 8;
 
+    int              parallelQualities;    // 0: number of available threads
+    const static int parallelQualities_min = 0;
+    const static int parallelQualities_max = 64;
+    const static int parallelQualities_default = 0;
+
+    int              threads;    // 0: OMP_NUM_THREADS resp. number of processors
+    const static int threads_min = 0;
+    const static int threads_max = 256;
+    const static int threads_default = 0;
+
+    int              memoryLimit;    // in MB; 0: unlimited, else images which would need more are shrunk in strips
+    const static int memoryLimit_min = 0;
+    const static int memoryLimit_max = 1024 * 1024;
+    const static int memoryLimit_default = 0;
+
+    QualitySearch::VALUE              qualitySearch;
+    const static QualitySearch::VALUE qualitySearch_default = QualitySearch::LINEAR;
+
+    bool              estimateQuality;    // limit qualityMax to the quality of the input
+    const static bool estimateQuality_default = true;
+
+    ComparisonEngine::VALUE              comparisonEngine;
+    const static ComparisonEngine::VALUE comparisonEngine_default = ComparisonEngine::PIXEL;
+
+    int              dssimPeakStride;    // 0: the peak is taken over the chunks
+    const static int dssimPeakStride_min = 0;
+    const static int dssimPeakStride_max = 256;
+    const static int dssimPeakStride_default = 0;
+
+    SimilarityMetric::VALUE              similarityMetric;
+    const static SimilarityMetric::VALUE similarityMetric_default = SimilarityMetric::BLOCK;
+
+    // weights of the planes (Y/Cb/Cr resp. R/G/B) in the DSSIM; 0: the plane is not compared
+    double                        dssimWeightY;
+    double                        dssimWeightCb;
+    double                        dssimWeightCr;
+    constexpr const static double dssimWeight_min = 0.0;
+    constexpr const static double dssimWeight_max = 1.0;
+    constexpr const static double dssimWeightY_default = 1.0;
+    constexpr const static double dssimWeightCb_default = 0.0;
+    constexpr const static double dssimWeightCr_default = 0.0;
+
+    StatisticsPrecision::VALUE              statisticsPrecision;    // block metric; the limits above are tuned for 8 bit
+    const static StatisticsPrecision::VALUE statisticsPrecision_default = StatisticsPrecision::BITS_8;
+
+    StatsFormat::VALUE              stats;    // per stage timings and counters of every image
+    const static StatsFormat::VALUE stats_default = StatsFormat::NONE;
+
+    bool              batch;    // inputFile is a directory or a file list, outputFile the output root
+    const static bool batch_default = false;
+
+    std::string cacheFile;    // empty: no result cache
+
     std::string inputFile;
     std::string outputFile;
 
@@ -73,6 +149,47 @@ struct Settings
         else
             return "false";
     }
+
+    const char * estimateQualityAsString()
+    {
+        if (estimateQuality)
+            return "true";
+        else
+            return "false";
+    }
+
+    const char * batchAsString()
+    {
+        if (batch)
+            return "true";
+        else
+            return "false";
+    }
+
+    const char * qualitySearchAsString()
+    {
+        return QualitySearch::toString( qualitySearch );
+    }
+
+    const char * comparisonEngineAsString()
+    {
+        return ComparisonEngine::toString( comparisonEngine );
+    }
+
+    const char * similarityMetricAsString()
+    {
+        return SimilarityMetric::toString( similarityMetric );
+    }
+
+    const char * statisticsPrecisionAsString()
+    {
+        return StatisticsPrecision::toString( statisticsPrecision );
+    }
+
+    const char * statsAsString()
+    {
+        return StatsFormat::toString( stats );
+    }
 };
 
 #endif // ENUM_SETTINGS_H_
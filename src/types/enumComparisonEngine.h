@@ -0,0 +1,28 @@
+
+#ifndef ENUM_COMPARISONENGINE_H_
+#define ENUM_COMPARISONENGINE_H_
+
+struct ComparisonEngine
+{
+    enum VALUE
+    {
+        UNKNOWN,
+        PIXEL,  // decode the candidate and compare the pixels
+        DCT,    // requantize the DCT coefficients of the input
+        STRIPS  // transcode and compare in strips without decoding the whole image
+    };
+
+    static const char * const toString( VALUE value )
+    {
+        switch( value )
+        {
+            case UNKNOWN: return "unknown";
+            case PIXEL:   return "pixel";
+            case DCT:     return "dct";
+            case STRIPS:  return "strips";
+            default:      return "ComparisonEngine ???";
+        }
+    }
+};
+
+#endif // ENUM_COMPARISONENGINE_H_
@@ -0,0 +1,28 @@
+
+#ifndef ENUM_QUALITYSEARCH_H_
+#define ENUM_QUALITYSEARCH_H_
+
+struct QualitySearch
+{
+    enum VALUE
+    {
+        UNKNOWN,
+        LINEAR,
+        BISECTION,
+        SECANT
+    };
+
+    static const char * const toString( VALUE value )
+    {
+        switch( value )
+        {
+            case UNKNOWN:   return "unknown";
+            case LINEAR:    return "linear";
+            case BISECTION: return "bisection";
+            case SECANT:    return "secant";
+            default:        return "QualitySearch ???";
+        }
+    }
+};
+
+#endif // ENUM_QUALITYSEARCH_H_
@@ -0,0 +1,28 @@
+
+#ifndef ENUM_SIMILARITYMETRIC_H_
+#define ENUM_SIMILARITYMETRIC_H_
+
+struct SimilarityMetric
+{
+    enum VALUE
+    {
+        UNKNOWN,
+        BLOCK,      // box windows of the chunk size, not overlapping
+        GAUSSIAN,   // 11x11 Gaussian window (sigma 1.5) at every pixel
+        MSSSIM      // 8x8 box windows on five scales
+    };
+
+    static const char * const toString( VALUE value )
+    {
+        switch( value )
+        {
+            case UNKNOWN:  return "unknown";
+            case BLOCK:    return "block";
+            case GAUSSIAN: return "gaussian";
+            case MSSSIM:   return "msssim";
+            default:       return "SimilarityMetric ???";
+        }
+    }
+};
+
+#endif // ENUM_SIMILARITYMETRIC_H_
@@ -0,0 +1,44 @@
+
+#ifndef ENUM_STAGE_H_
+#define ENUM_STAGE_H_
+
+struct Stage
+{
+    enum VALUE
+    {
+        UNKNOWN,
+        LOAD_IMAGE,         // read resp. map the file, the header and the markers (and the decoding if done on loading)
+        DECOMPRESS,         // TurboJPEG decoding (without the header)
+        COMPRESS,           // TurboJPEG encoding (without the chroma conversion) resp. transcoding in strips
+        CHROMA_444TO420,
+        CHROMA_420TO444,
+        AVERAGE,
+        VARIANCE,
+        COVARIANCE,
+        STATISTICS,         // chunk sums of the block metric
+        DSSIM               // contains the covariance for image collections
+    };
+
+    static const int nofValues = DSSIM + 1;
+
+    static const char * const toString( VALUE value )
+    {
+        switch( value )
+        {
+            case UNKNOWN:         return "unknown";
+            case LOAD_IMAGE:      return "loadImage";
+            case DECOMPRESS:      return "decompress";
+            case COMPRESS:        return "compress";
+            case CHROMA_444TO420: return "chroma444to420";
+            case CHROMA_420TO444: return "chroma420to444";
+            case AVERAGE:         return "average";
+            case VARIANCE:        return "variance";
+            case COVARIANCE:      return "covariance";
+            case STATISTICS:      return "statistics";
+            case DSSIM:           return "dssim";
+            default:              return "Stage ???";
+        }
+    }
+};
+
+#endif // ENUM_STAGE_H_
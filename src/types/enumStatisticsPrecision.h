@@ -0,0 +1,26 @@
+
+#ifndef ENUM_STATISTICSPRECISION_H_
+#define ENUM_STATISTICSPRECISION_H_
+
+struct StatisticsPrecision
+{
+    enum VALUE
+    {
+        UNKNOWN,
+        BITS_8,     // average, variance and covariance truncated to 8 bit like the original images
+        FLOAT       // exact per chunk; negative covariances are kept
+    };
+
+    static const char * const toString( VALUE value )
+    {
+        switch( value )
+        {
+            case UNKNOWN:  return "unknown";
+            case BITS_8:   return "8bit";
+            case FLOAT:    return "float";
+            default:       return "StatisticsPrecision ???";
+        }
+    }
+};
+
+#endif // ENUM_STATISTICSPRECISION_H_
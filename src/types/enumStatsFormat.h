@@ -0,0 +1,26 @@
+
+#ifndef ENUM_STATSFORMAT_H_
+#define ENUM_STATSFORMAT_H_
+
+struct StatsFormat
+{
+    enum VALUE
+    {
+        UNKNOWN,
+        NONE,   // no instrumentation at all
+        JSON    // one JSON record per image
+    };
+
+    static const char * const toString( VALUE value )
+    {
+        switch( value )
+        {
+            case UNKNOWN: return "unknown";
+            case NONE:    return "none";
+            case JSON:    return "json";
+            default:      return "StatsFormat ???";
+        }
+    }
+};
+
+#endif // ENUM_STATSFORMAT_H_
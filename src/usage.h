@@ -9,6 +9,9 @@ void printUsage()
     std::cout << "imageshrink [settings] inputFile outputFile"
               << std::endl;
 
+    std::cout << "imageshrink [settings] --batch true inputDirectory|fileList|- outputDirectory"
+              << std::endl;
+
     std::cout << std::endl;
 
     std::cout << "settings:"
@@ -84,6 +87,100 @@ void printUsage()
               << Settings::imageCompChunkSize_default
               << ")"
               << std::endl;
+
+    std::cout << "    --parallelQualities value   qualities evaluated concurrently, 0 = number of threads "
+              << "(" << Settings::parallelQualities_min
+              << " <= value <= "
+              << Settings::parallelQualities_max
+              << ", default = "
+              << Settings::parallelQualities_default
+              << ")"
+              << std::endl;
+
+    std::cout << "    --threads value             number of threads, 0 = OMP_NUM_THREADS or the number of processors "
+              << "(" << Settings::threads_min
+              << " <= value <= "
+              << Settings::threads_max
+              << ", default = "
+              << Settings::threads_default
+              << ")"
+              << std::endl;
+
+    std::cout << "    --memoryLimit value         memory per image in MB, images which would need more are shrunk in strips, 0 = unlimited "
+              << "(" << Settings::memoryLimit_min
+              << " <= value <= "
+              << Settings::memoryLimit_max
+              << ", default = "
+              << Settings::memoryLimit_default
+              << ")"
+              << std::endl;
+
+    std::cout << "    --search value              strategy for the quality search "
+              << "(value = linear|bisection|secant, default = "
+              << s.qualitySearchAsString()
+              << ")"
+              << std::endl;
+
+    std::cout << "    --estimateQuality value     limit the maximum quality to the quality of the input "
+              << "(value = true|false, default = "
+              << s.estimateQualityAsString()
+              << ")"
+              << std::endl;
+
+    std::cout << "    --engine value              pixel: encode and decode every candidate, dct: requantize the DCT coefficients of the input, strips: transcode and compare in strips "
+              << "(value = pixel|dct|strips, default = "
+              << s.comparisonEngineAsString()
+              << ")"
+              << std::endl;
+
+    std::cout << "    --dssimPeakStride value     stride of the sliding windows for the peak DSSIM, 0 = the chunks do not overlap "
+              << "(" << Settings::dssimPeakStride_min
+              << " <= value <= "
+              << Settings::dssimPeakStride_max
+              << ", default = "
+              << Settings::dssimPeakStride_default
+              << ")"
+              << std::endl;
+
+    std::cout << "    --metric value              block: box windows of the chunk size, gaussian: 11x11 Gaussian windows at every pixel, msssim: 8x8 windows on five scales (pixel engine only) "
+              << "(value = block|gaussian|msssim, default = "
+              << s.similarityMetricAsString()
+              << ")"
+              << std::endl;
+
+    std::cout << "    --dssimWeights y,cb,cr      weights of the planes in the DSSIM, 0 = the plane is not compared (block metric only) "
+              << "("
+              << Settings::dssimWeight_min
+              << " <= value <= "
+              << Settings::dssimWeight_max
+              << ", default = "
+              << Settings::dssimWeightY_default << ","
+              << Settings::dssimWeightCb_default << ","
+              << Settings::dssimWeightCr_default
+              << ")"
+              << std::endl;
+
+    std::cout << "    --statistics value          8bit: mean, variance and covariance of a chunk are truncated to 8 bit, float: they are exact (block metric only) "
+              << "(value = 8bit|float, default = "
+              << s.statisticsPrecisionAsString()
+              << ")"
+              << std::endl;
+
+    std::cout << "    --stats value               json: print the timings of the stages, the allocations and the candidates of every image as one JSON line "
+              << "(value = none|json, default = "
+              << s.statsAsString()
+              << ")"
+              << std::endl;
+
+    std::cout << "    --batch value               shrink all jpeg files of a directory tree or of a file list (- = stdin) into the output directory "
+              << "(value = true|false, default = "
+              << s.batchAsString()
+              << ")"
+              << std::endl;
+
+    std::cout << "    --cache file                reuse the results of images shrunk before with the same settings "
+              << "(default = no cache)"
+              << std::endl;
 }
 
 #endif // ENUM_USAGE_H_